@@ -0,0 +1,438 @@
+// Self-contained benchmarks of the public S21Matrix operations.
+//
+// Usage: ./bench_run [--json=FILE] [--filter=TEXT] [--min-size=N]
+//                    [--max-size=N] [--min-time=SECONDS]
+//
+// Each operation runs on square n x n operands for n = 2, 4, 8, ... 4096.
+// Reported per operation: wall time, GFLOP/s where the operation has a
+// meaningful flop count, and the heap bytes and allocations it makes, which
+// are counted by replacing the global operator new below.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "s21_matrix_lu.h"
+#include "s21_matrix_oop.h"
+#include "s21_matrix_parallel.h"
+#include "s21_matrix_simd.h"
+#include "s21_matrix_solve.h"
+
+namespace {
+
+std::atomic<std::size_t> allocated_bytes{0};
+std::atomic<std::size_t> allocation_count{0};
+
+void* countedAllocate(std::size_t bytes, std::size_t alignment) {
+  allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+  void* block = nullptr;
+  if (alignment <= alignof(std::max_align_t)) {
+    block = std::malloc(bytes ? bytes : 1);
+  } else if (posix_memalign(&block, alignment, bytes ? bytes : 1) != 0) {
+    block = nullptr;
+  }
+
+  if (!block) {
+    throw std::bad_alloc();
+  }
+
+  return block;
+}
+
+}  // namespace
+
+void* operator new(std::size_t bytes) { return countedAllocate(bytes, 0); }
+void* operator new[](std::size_t bytes) { return countedAllocate(bytes, 0); }
+void* operator new(std::size_t bytes, std::align_val_t alignment) {
+  return countedAllocate(bytes, static_cast<std::size_t>(alignment));
+}
+void* operator new[](std::size_t bytes, std::align_val_t alignment) {
+  return countedAllocate(bytes, static_cast<std::size_t>(alignment));
+}
+void operator delete(void* block) noexcept { std::free(block); }
+void operator delete[](void* block) noexcept { std::free(block); }
+void operator delete(void* block, std::size_t) noexcept { std::free(block); }
+void operator delete[](void* block, std::size_t) noexcept { std::free(block); }
+void operator delete(void* block, std::align_val_t) noexcept {
+  std::free(block);
+}
+void operator delete[](void* block, std::align_val_t) noexcept {
+  std::free(block);
+}
+void operator delete(void* block, std::size_t, std::align_val_t) noexcept {
+  std::free(block);
+}
+void operator delete[](void* block, std::size_t, std::align_val_t) noexcept {
+  std::free(block);
+}
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Runs one operation; built once per size so setup stays out of the timing.
+using Body = std::function<void()>;
+
+struct Benchmark {
+  const char* name;
+  // Floating point operations of one run on n x n operands, 0 if the
+  // operation only moves data.
+  double (*flops)(double n);
+  Body (*setup)(int n);
+};
+
+struct Result {
+  std::string name;
+  int size;
+  long iterations;
+  double ns_per_op;
+  double gflops;
+  double bytes_per_op;
+  double allocs_per_op;
+};
+
+struct Options {
+  const char* json = nullptr;
+  const char* filter = nullptr;
+  int min_size = 2;
+  int max_size = 4096;
+  double min_time = 0.2;
+};
+
+// Deterministic, well-conditioned operands: diagonally dominant so that
+// Determinant, InverseMatrix and CalcComplements take their regular paths.
+S21Matrix Operand(const int n, const int seed) {
+  S21Matrix mat(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      mat(i, j) = ((i * 31 + j * 17 + seed) % 23) * 0.125 - 1;
+    }
+    mat(i, i) += 3 * n;
+  }
+  return mat;
+}
+
+// Tall, skinny least-squares operands: (256 * n) x kTallCols, so size 4096
+// is about a million rows.
+constexpr int kTallCols = 64;
+
+S21Matrix TallOperand(const int n, const int seed) {
+  S21Matrix mat(256 * n, kTallCols);
+  for (int i = 0; i < mat.getRows(); ++i) {
+    double* row = mat.row(i);
+    for (int j = 0; j < kTallCols; ++j) {
+      row[j] = ((i * 31 + j * 17 + seed) % 23) * 0.125 - 1;
+    }
+  }
+  for (int j = 0; j < kTallCols; ++j) {
+    mat(j, j) += 3 * kTallCols;
+  }
+  return mat;
+}
+
+// Keeps a result alive so the compiler cannot drop the operation.
+volatile double sink;
+
+double None(double) { return 0; }
+double Square(double n) { return n * n; }
+double TwoSquare(double n) { return 2 * n * n; }
+double TwoCube(double n) { return 2 * n * n * n; }
+double LUCube(double n) { return 2.0 / 3 * n * n * n; }
+double CholeskyCube(double n) { return n * n * n / 3; }
+double TallQR(double n) {
+  const double m = 256 * n, k = kTallCols;
+  return 2 * m * k * k - 2.0 / 3 * k * k * k;
+}
+
+const Benchmark kBenchmarks[] = {
+    {"Construct", None,
+     [](int n) -> Body {
+       return [n] {
+         S21Matrix mat(n, n);
+         sink = mat(0, 0);
+       };
+     }},
+    {"Copy", None,
+     [](int n) -> Body {
+       auto a = std::make_shared<S21Matrix>(Operand(n, 1));
+       return [a] {
+         S21Matrix copy(*a);
+         sink = copy(0, 0);
+       };
+     }},
+    {"Move", None,
+     [](int n) -> Body {
+       auto a = std::make_shared<S21Matrix>(Operand(n, 1));
+       return [a] {
+         S21Matrix moved(std::move(*a));
+         *a = std::move(moved);
+       };
+     }},
+    {"CopyAssign", None,
+     [](int n) -> Body {
+       auto a = std::make_shared<S21Matrix>(Operand(n, 1));
+       auto b = std::make_shared<S21Matrix>(n, n);
+       return [a, b] { *b = *a; };
+     }},
+    {"EqMatrix", Square,
+     [](int n) -> Body {
+       auto a = std::make_shared<S21Matrix>(Operand(n, 1));
+       auto b = std::make_shared<S21Matrix>(*a);
+       return [a, b] { sink = a->EqMatrix(*b); };
+     }},
+    {"SumMatrix", Square,
+     [](int n) -> Body {
+       auto a = std::make_shared<S21Matrix>(Operand(n, 1));
+       auto b = std::make_shared<S21Matrix>(Operand(n, 2));
+       return [a, b] { a->SumMatrix(*b); };
+     }},
+    {"SubMatrix", Square,
+     [](int n) -> Body {
+       auto a = std::make_shared<S21Matrix>(Operand(n, 1));
+       auto b = std::make_shared<S21Matrix>(Operand(n, 2));
+       return [a, b] { a->SubMatrix(*b); };
+     }},
+    {"MulNumber", Square,
+     [](int n) -> Body {
+       auto a = std::make_shared<S21Matrix>(Operand(n, 1));
+       return [a] { a->MulNumber(1.0000001); };
+     }},
+    {"Expression", TwoSquare,
+     [](int n) -> Body {
+       auto a = std::make_shared<S21Matrix>(Operand(n, 1));
+       auto b = std::make_shared<S21Matrix>(Operand(n, 2));
+       auto c = std::make_shared<S21Matrix>(n, n);
+       return [a, b, c] { *c = *a + *b * 2.0; };
+     }},
+    {"MulMatrix", TwoCube,
+     [](int n) -> Body {
+       auto a = std::make_shared<S21Matrix>(Operand(n, 1));
+       auto b = std::make_shared<S21Matrix>(Operand(n, 2));
+       return [a, b] {
+         S21Matrix c = *a * *b;
+         sink = c(0, 0);
+       };
+     }},
+    {"Transpose", None,
+     [](int n) -> Body {
+       auto a = std::make_shared<S21Matrix>(Operand(n, 1));
+       return [a] {
+         S21Matrix t = a->Transpose();
+         sink = t(0, 0);
+       };
+     }},
+    {"TransposeInPlace", None,
+     [](int n) -> Body {
+       auto a = std::make_shared<S21Matrix>(Operand(n, 1));
+       return [a] {
+         a->TransposeInPlace();
+         sink = (*a)(0, 0);
+       };
+     }},
+    {"Minor", None,
+     [](int n) -> Body {
+       auto a = std::make_shared<S21Matrix>(Operand(n, 1));
+       return [a] {
+         S21Matrix minor = a->Minor(0, 0);
+         sink = minor.getRows();
+       };
+     }},
+    {"Determinant", LUCube,
+     [](int n) -> Body {
+       auto a = std::make_shared<S21Matrix>(Operand(n, 1));
+       return [a] { sink = a->Determinant(); };
+     }},
+    {"InverseMatrix", TwoCube,
+     [](int n) -> Body {
+       auto a = std::make_shared<S21Matrix>(Operand(n, 1));
+       return [a] {
+         S21Matrix inverse = a->InverseMatrix();
+         sink = inverse(0, 0);
+       };
+     }},
+    {"CalcComplements", TwoCube,
+     [](int n) -> Body {
+       auto a = std::make_shared<S21Matrix>(Operand(n, 1));
+       return [a] {
+         S21Matrix complements = a->CalcComplements();
+         sink = complements(0, 0);
+       };
+     }},
+    {"Solve", LUCube,
+     [](int n) -> Body {
+       auto a = std::make_shared<S21Matrix>(Operand(n, 1));
+       auto b = std::make_shared<S21Matrix>(n, 1);
+       return [a, b] {
+         S21Matrix x = s21_solve(*a, *b, S21Structure::kGeneral);
+         sink = x(0, 0);
+       };
+     }},
+    {"CholeskySolve", CholeskyCube,
+     [](int n) -> Body {
+       // A + A^T keeps the dominant diagonal, so it is positive definite.
+       S21Matrix operand = Operand(n, 1);
+       auto a = std::make_shared<S21Matrix>(operand + operand.Transpose());
+       auto b = std::make_shared<S21Matrix>(n, 1);
+       return [a, b] {
+         S21Matrix x = s21_solve(*a, *b,
+                                 S21Structure::kSymmetricPositiveDefinite);
+         sink = x(0, 0);
+       };
+     }},
+    {"LUSolveFactored", TwoSquare,
+     [](int n) -> Body {
+       auto lu = std::make_shared<S21LU>(Operand(n, 1));
+       auto b = std::make_shared<S21Matrix>(n, 1);
+       return [lu, b] { lu->SolveInPlace(*b); };
+     }},
+    {"LeastSquares", TallQR,
+     [](int n) -> Body {
+       auto a = std::make_shared<S21Matrix>(TallOperand(n, 1));
+       auto b = std::make_shared<S21Matrix>(TallOperand(n, 2));
+       b->setCols(1);
+       return [a, b] {
+         S21Matrix x = s21_least_squares(*a, *b);
+         sink = x(0, 0);
+       };
+     }},
+};
+
+// The first pass runs once, doubles as warm-up and sets the iteration count
+// for the measured pass. A single run that already takes min_time is
+// reported as is.
+Result Run(const Benchmark& benchmark, const int n, const double min_time) {
+  Body body = benchmark.setup(n);
+
+  long iterations = 1;
+  double seconds = 0;
+  std::size_t bytes = 0, allocs = 0;
+  for (;;) {
+    const std::size_t bytes_before = allocated_bytes.load();
+    const std::size_t allocs_before = allocation_count.load();
+    const Clock::time_point start = Clock::now();
+    for (long i = 0; i < iterations; ++i) {
+      body();
+    }
+    seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    bytes = allocated_bytes.load() - bytes_before;
+    allocs = allocation_count.load() - allocs_before;
+
+    if (seconds >= min_time) {
+      break;
+    }
+    const double per_op = std::max(seconds / iterations, 1e-9);
+    iterations = static_cast<long>(min_time / per_op * 1.2) + 1;
+  }
+
+  Result result;
+  result.name = std::string(benchmark.name) + "/" + std::to_string(n);
+  result.size = n;
+  result.iterations = iterations;
+  result.ns_per_op = seconds * 1e9 / iterations;
+  result.gflops = benchmark.flops(n) / result.ns_per_op;
+  result.bytes_per_op = static_cast<double>(bytes) / iterations;
+  result.allocs_per_op = static_cast<double>(allocs) / iterations;
+  return result;
+}
+
+bool WriteJson(const char* path, const std::vector<Result>& results) {
+  std::FILE* file = std::fopen(path, "w");
+  if (!file) {
+    return false;
+  }
+
+  char date[32];
+  const std::time_t now = std::time(nullptr);
+  std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+  std::fprintf(file, "{\n  \"context\": {\n");
+  std::fprintf(file, "    \"date\": \"%s\",\n", date);
+  std::fprintf(file, "    \"threads\": %d,\n", s21_get_num_threads());
+  std::fprintf(file, "    \"simd\": \"%s\"\n", s21_simd_kernels().name);
+  std::fprintf(file, "  },\n  \"benchmarks\": [");
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    const Result& r = results[i];
+    std::fprintf(file,
+                 "%s\n    {\"name\": \"%s\", \"size\": %d, "
+                 "\"iterations\": %ld, \"ns_per_op\": %.3f, "
+                 "\"gflops\": %.4f, \"bytes_per_op\": %.1f, "
+                 "\"allocs_per_op\": %.2f}",
+                 i ? "," : "", r.name.c_str(), r.size, r.iterations,
+                 r.ns_per_op, r.gflops, r.bytes_per_op, r.allocs_per_op);
+  }
+  std::fprintf(file, "\n  ]\n}\n");
+
+  return std::fclose(file) == 0;
+}
+
+bool ParseOptions(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; ++i) {
+    const char* arg = argv[i];
+    if (!std::strncmp(arg, "--json=", 7)) {
+      options.json = arg + 7;
+    } else if (!std::strncmp(arg, "--filter=", 9)) {
+      options.filter = arg + 9;
+    } else if (!std::strncmp(arg, "--min-size=", 11)) {
+      options.min_size = std::atoi(arg + 11);
+    } else if (!std::strncmp(arg, "--max-size=", 11)) {
+      options.max_size = std::atoi(arg + 11);
+    } else if (!std::strncmp(arg, "--min-time=", 11)) {
+      options.min_time = std::atof(arg + 11);
+    } else {
+      std::fprintf(stderr, "bench: unknown argument %s\n", arg);
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!ParseOptions(argc, argv, options)) {
+    return 2;
+  }
+
+  std::printf("threads %d, simd %s\n", s21_get_num_threads(),
+              s21_simd_kernels().name);
+  std::printf("%-24s %12s %12s %10s %14s %10s\n", "benchmark", "iterations",
+              "ns/op", "GFLOP/s", "bytes/op", "allocs/op");
+
+  std::vector<Result> results;
+  for (const Benchmark& benchmark : kBenchmarks) {
+    if (options.filter && !std::strstr(benchmark.name, options.filter)) {
+      continue;
+    }
+    for (int n = 2; n <= options.max_size; n *= 2) {
+      if (n < options.min_size) {
+        continue;
+      }
+      const Result r = Run(benchmark, n, options.min_time);
+      std::printf("%-24s %12ld %12.1f %10.3f %14.1f %10.2f\n", r.name.c_str(),
+                  r.iterations, r.ns_per_op, r.gflops, r.bytes_per_op,
+                  r.allocs_per_op);
+      std::fflush(stdout);
+      results.push_back(r);
+    }
+  }
+
+  if (options.json && !WriteJson(options.json, results)) {
+    std::fprintf(stderr, "bench: cannot write %s\n", options.json);
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,68 @@
+#!/usr/bin/env python3
+"""Compares two JSON reports written by `bench_run --json=FILE`.
+
+Usage: bench_compare.py BASELINE CURRENT [--threshold=0.10]
+
+A benchmark regresses when its ns/op grows by more than the threshold or
+when it starts allocating more bytes per operation. Exits with status 1 if
+any benchmark regressed.
+"""
+
+import json
+import sys
+
+
+def load(path):
+    with open(path) as file:
+        return {b["name"]: b for b in json.load(file)["benchmarks"]}
+
+
+def main(argv):
+    threshold = 0.10
+    paths = []
+    for arg in argv[1:]:
+        if arg.startswith("--threshold="):
+            threshold = float(arg.split("=", 1)[1])
+        else:
+            paths.append(arg)
+    if len(paths) != 2:
+        print(__doc__.strip(), file=sys.stderr)
+        return 2
+
+    baseline, current = load(paths[0]), load(paths[1])
+    regressions = 0
+
+    print("%-24s %14s %14s %9s %14s  %s" %
+          ("benchmark", "base ns/op", "ns/op", "change", "bytes/op", ""))
+    for name, cur in current.items():
+        base = baseline.get(name)
+        if base is None:
+            print("%-24s %14s %14.1f %9s %14.1f  new" %
+                  (name, "-", cur["ns_per_op"], "-", cur["bytes_per_op"]))
+            continue
+
+        change = cur["ns_per_op"] / base["ns_per_op"] - 1
+        flags = []
+        if change > threshold:
+            flags.append("SLOWER")
+        elif change < -threshold:
+            flags.append("faster")
+        if cur["bytes_per_op"] > base["bytes_per_op"] * (1 + threshold) + 64:
+            flags.append("MORE ALLOCATION")
+        if "SLOWER" in flags or "MORE ALLOCATION" in flags:
+            regressions += 1
+
+        print("%-24s %14.1f %14.1f %+8.1f%% %14.1f  %s" %
+              (name, base["ns_per_op"], cur["ns_per_op"], change * 100,
+               cur["bytes_per_op"], " ".join(flags)))
+
+    for name in baseline:
+        if name not in current:
+            print("%-24s missing from current run" % name)
+
+    print("%d regression(s) above %.0f%%" % (regressions, threshold * 100))
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
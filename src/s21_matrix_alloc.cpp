@@ -0,0 +1,258 @@
+#include "s21_matrix_alloc.h"
+
+#include <algorithm>
+#include <new>
+
+namespace {
+
+thread_local S21Allocator* current_allocator = nullptr;
+
+std::size_t alignUp(const std::size_t value) noexcept {
+  return (value + S21Allocator::kAlignment - 1) &
+         ~(S21Allocator::kAlignment - 1);
+}
+
+}  // namespace
+
+// S21HeapAllocator
+
+S21HeapAllocator& S21HeapAllocator::Instance() noexcept {
+  static S21HeapAllocator allocator;
+  return allocator;
+}
+
+void* S21HeapAllocator::Allocate(const std::size_t bytes) {
+  return ::operator new(bytes, std::align_val_t(kAlignment));
+}
+
+void S21HeapAllocator::Deallocate(void* block, const std::size_t) noexcept {
+  ::operator delete(block, std::align_val_t(kAlignment));
+}
+
+// S21PoolAllocator
+
+struct S21PoolAllocator::ThreadCache {
+  std::vector<void*> blocks[kClasses];
+
+  ~ThreadCache() {
+    // The pool is never destroyed, so blocks can always go back to it.
+    S21PoolAllocator& pool = S21PoolAllocator::Instance();
+    for (int i = 0; i < kClasses; ++i) {
+      for (void* block : blocks[i]) {
+        pool.release(i, block);
+      }
+    }
+  }
+};
+
+S21PoolAllocator& S21PoolAllocator::Instance() noexcept {
+  // Intentionally leaked: thread caches flush into it at thread exit, which
+  // may happen after static destructors have run.
+  static S21PoolAllocator* pool = new S21PoolAllocator();
+  return *pool;
+}
+
+int S21PoolAllocator::sizeClass(const std::size_t bytes) noexcept {
+  int size_class = 0;
+  std::size_t size = kMinClassBytes;
+  while (size < bytes) {
+    size <<= 1;
+    ++size_class;
+  }
+  return size_class;
+}
+
+S21PoolAllocator::ThreadCache& S21PoolAllocator::threadCache() noexcept {
+  thread_local ThreadCache cache;
+  return cache;
+}
+
+void* S21PoolAllocator::Allocate(const std::size_t bytes) {
+  if (bytes > kMaxPooledBytes) {
+    return S21HeapAllocator::Instance().Allocate(bytes);
+  }
+
+  const int size_class = sizeClass(bytes);
+  std::vector<void*>& cached = threadCache().blocks[size_class];
+  if (!cached.empty()) {
+    void* block = cached.back();
+    cached.pop_back();
+    return block;
+  }
+
+  FreeList& list = lists_[size_class];
+  {
+    std::lock_guard<std::mutex> lock(list.mutex);
+    if (!list.blocks.empty()) {
+      void* block = list.blocks.back();
+      list.blocks.pop_back();
+      return block;
+    }
+  }
+
+  return S21HeapAllocator::Instance().Allocate(kMinClassBytes << size_class);
+}
+
+void S21PoolAllocator::Deallocate(void* block,
+                                  const std::size_t bytes) noexcept {
+  if (block == nullptr) {
+    return;
+  }
+
+  if (bytes > kMaxPooledBytes) {
+    S21HeapAllocator::Instance().Deallocate(block, bytes);
+    return;
+  }
+
+  const int size_class = sizeClass(bytes);
+  std::vector<void*>& cached = threadCache().blocks[size_class];
+  if ((bytes <= kMaxThreadCachedBytes) &&
+      (cached.size() < kThreadCacheBlocks)) {
+    try {
+      cached.push_back(block);
+      return;
+    } catch (...) {
+    }
+  }
+
+  release(size_class, block);
+}
+
+void S21PoolAllocator::release(const int size_class, void* block) noexcept {
+  FreeList& list = lists_[size_class];
+  std::lock_guard<std::mutex> lock(list.mutex);
+  try {
+    list.blocks.push_back(block);
+  } catch (...) {
+    S21HeapAllocator::Instance().Deallocate(block, 0);
+  }
+}
+
+void S21PoolAllocator::Trim() noexcept {
+  ThreadCache& cache = threadCache();
+  for (int i = 0; i < kClasses; ++i) {
+    for (void* block : cache.blocks[i]) {
+      S21HeapAllocator::Instance().Deallocate(block, 0);
+    }
+    cache.blocks[i].clear();
+
+    std::lock_guard<std::mutex> lock(lists_[i].mutex);
+    for (void* block : lists_[i].blocks) {
+      S21HeapAllocator::Instance().Deallocate(block, 0);
+    }
+    lists_[i].blocks.clear();
+  }
+}
+
+std::size_t S21PoolAllocator::getCachedBlocks() noexcept {
+  std::size_t count = 0;
+  for (int i = 0; i < kClasses; ++i) {
+    std::lock_guard<std::mutex> lock(lists_[i].mutex);
+    count += lists_[i].blocks.size();
+  }
+  return count;
+}
+
+// S21Arena
+
+S21Arena::S21Arena(const std::size_t chunk_bytes)
+    : chunks_(),
+      chunk_bytes_(alignUp(std::max(chunk_bytes, kAlignment))),
+      current_(0),
+      offset_(0),
+      used_before_(0) {}
+
+S21Arena::~S21Arena() {
+  for (const Chunk& chunk : chunks_) {
+    S21HeapAllocator::Instance().Deallocate(chunk.data, chunk.size);
+  }
+}
+
+void* S21Arena::Allocate(const std::size_t bytes) {
+  const std::size_t size = alignUp(std::max<std::size_t>(bytes, 1));
+
+  while (current_ < chunks_.size()) {
+    Chunk& chunk = chunks_[current_];
+    if (offset_ + size <= chunk.size) {
+      void* block = chunk.data + offset_;
+      offset_ += size;
+      return block;
+    }
+    used_before_ += offset_;
+    ++current_;
+    offset_ = 0;
+  }
+
+  const std::size_t chunk_size = std::max(chunk_bytes_, size);
+  Chunk chunk = {static_cast<char*>(
+                     S21HeapAllocator::Instance().Allocate(chunk_size)),
+                 chunk_size};
+  try {
+    chunks_.push_back(chunk);
+  } catch (...) {
+    S21HeapAllocator::Instance().Deallocate(chunk.data, chunk.size);
+    throw;
+  }
+
+  current_ = chunks_.size() - 1;
+  offset_ = size;
+  return chunk.data;
+}
+
+void S21Arena::Deallocate(void* block, const std::size_t bytes) noexcept {
+  if ((block == nullptr) || (current_ >= chunks_.size())) {
+    return;
+  }
+
+  const std::size_t size = alignUp(std::max<std::size_t>(bytes, 1));
+  char* top = chunks_[current_].data + offset_;
+  if ((offset_ >= size) && (static_cast<char*>(block) + size == top)) {
+    offset_ -= size;
+  }
+}
+
+void S21Arena::Reset() noexcept {
+  current_ = 0;
+  offset_ = 0;
+  used_before_ = 0;
+}
+
+std::size_t S21Arena::getUsed() const noexcept {
+  return used_before_ + offset_;
+}
+
+std::size_t S21Arena::getCapacity() const noexcept {
+  std::size_t capacity = 0;
+  for (const Chunk& chunk : chunks_) {
+    capacity += chunk.size;
+  }
+  return capacity;
+}
+
+// Current allocator
+
+S21Allocator& s21_get_allocator() noexcept {
+  return current_allocator != nullptr ? *current_allocator
+                                      : S21HeapAllocator::Instance();
+}
+
+void s21_set_allocator(S21Allocator* allocator) noexcept {
+  current_allocator = allocator;
+}
+
+S21AllocatorScope::S21AllocatorScope(S21Allocator& allocator) noexcept
+    : previous_(current_allocator), arena_(nullptr) {
+  current_allocator = &allocator;
+}
+
+S21AllocatorScope::S21AllocatorScope(S21Arena& arena) noexcept
+    : previous_(current_allocator), arena_(&arena) {
+  current_allocator = &arena;
+}
+
+S21AllocatorScope::~S21AllocatorScope() {
+  current_allocator = previous_;
+  if (arena_) {
+    arena_->Reset();
+  }
+}
@@ -0,0 +1,125 @@
+#ifndef S21_MATRIX_ALLOC_H_
+#define S21_MATRIX_ALLOC_H_
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+// Source of matrix buffers. Returned blocks must be aligned to kAlignment
+// bytes. Deallocate receives the same size that was requested.
+class S21Allocator {
+ public:
+  static constexpr std::size_t kAlignment = 64;
+
+  virtual ~S21Allocator() = default;
+
+  virtual void* Allocate(const std::size_t bytes) = 0;
+  virtual void Deallocate(void* block, const std::size_t bytes) noexcept = 0;
+};
+
+// Aligned global operator new / delete. Used unless something else is set.
+class S21HeapAllocator : public S21Allocator {
+ public:
+  static S21HeapAllocator& Instance() noexcept;
+
+  void* Allocate(const std::size_t bytes) override;
+  void Deallocate(void* block, const std::size_t bytes) noexcept override;
+};
+
+// Process-wide pool with power-of-two size classes. Freed blocks are kept
+// for reuse, first in a small per-thread cache and then in shared free
+// lists. Only blocks up to kMaxThreadCachedBytes are cached per thread;
+// blocks above kMaxPooledBytes go straight to the heap.
+class S21PoolAllocator : public S21Allocator {
+ public:
+  static constexpr std::size_t kMinClassBytes = 64;
+  static constexpr std::size_t kMaxPooledBytes = std::size_t(1) << 26;
+  static constexpr int kClasses = 21;
+  static constexpr std::size_t kMaxThreadCachedBytes = std::size_t(1) << 20;
+  static constexpr std::size_t kThreadCacheBlocks = 8;
+
+  static S21PoolAllocator& Instance() noexcept;
+
+  S21PoolAllocator(const S21PoolAllocator&) = delete;
+  S21PoolAllocator& operator=(const S21PoolAllocator&) = delete;
+
+  void* Allocate(const std::size_t bytes) override;
+  void Deallocate(void* block, const std::size_t bytes) noexcept override;
+
+  // Returns every cached block of the shared lists and of the calling
+  // thread's cache to the heap.
+  void Trim() noexcept;
+
+  // Number of blocks currently cached in the shared lists.
+  std::size_t getCachedBlocks() noexcept;
+
+ private:
+  struct FreeList {
+    std::mutex mutex;
+    std::vector<void*> blocks;
+  };
+
+  struct ThreadCache;
+
+  FreeList lists_[kClasses];
+
+  S21PoolAllocator() = default;
+  ~S21PoolAllocator() = default;
+
+  static int sizeClass(const std::size_t bytes) noexcept;
+  static ThreadCache& threadCache() noexcept;
+  void release(const int size_class, void* block) noexcept;
+};
+
+// Bump allocator for batches of short-lived matrices. Deallocate only
+// reclaims the most recent block; Reset() rewinds everything in O(1) and
+// keeps the chunks for the next batch. Matrices allocated from an arena
+// must not be used after it is reset or destroyed.
+class S21Arena : public S21Allocator {
+ public:
+  explicit S21Arena(const std::size_t chunk_bytes = std::size_t(1) << 20);
+  S21Arena(const S21Arena&) = delete;
+  S21Arena& operator=(const S21Arena&) = delete;
+  ~S21Arena() override;
+
+  void* Allocate(const std::size_t bytes) override;
+  void Deallocate(void* block, const std::size_t bytes) noexcept override;
+
+  void Reset() noexcept;
+  std::size_t getUsed() const noexcept;
+  std::size_t getCapacity() const noexcept;
+
+ private:
+  struct Chunk {
+    char* data;
+    std::size_t size;
+  };
+
+  std::vector<Chunk> chunks_;
+  std::size_t chunk_bytes_;
+  std::size_t current_;
+  std::size_t offset_;
+  std::size_t used_before_;
+};
+
+// Allocator used for matrices created on the calling thread.
+S21Allocator& s21_get_allocator() noexcept;
+void s21_set_allocator(S21Allocator* allocator) noexcept;
+
+// Installs an allocator for the calling thread for the lifetime of the
+// scope and restores the previous one afterwards. An arena is also reset
+// when the scope ends.
+class S21AllocatorScope {
+ public:
+  explicit S21AllocatorScope(S21Allocator& allocator) noexcept;
+  explicit S21AllocatorScope(S21Arena& arena) noexcept;
+  S21AllocatorScope(const S21AllocatorScope&) = delete;
+  S21AllocatorScope& operator=(const S21AllocatorScope&) = delete;
+  ~S21AllocatorScope();
+
+ private:
+  S21Allocator* previous_;
+  S21Arena* arena_;
+};
+
+#endif  // S21_MATRIX_ALLOC_H_
@@ -0,0 +1,193 @@
+#include "s21_matrix_async.h"
+
+#include <algorithm>
+
+#include "s21_matrix_gemm.h"
+#include "s21_matrix_lu.h"
+#include "s21_matrix_parallel.h"
+#include "s21_matrix_stats.h"
+
+namespace {
+
+// Rows of the product computed between two cancellation checks.
+constexpr int kCancelBand = 256;
+
+void throwIfCancelled(const S21TaskState& state) {
+  if (state.IsCancelled()) {
+    throw S21TaskCancelled();
+  }
+}
+
+template <typename T>
+S21BasicMatrix<T> multiply(const S21BasicMatrix<T>& a,
+                           const S21BasicMatrix<T>& b,
+                           const S21TaskState& state) {
+  const int m = a.getRows();
+  const int n = b.getCols();
+  const int k = a.getCols();
+
+  if (b.getRows() != k) {
+    throw std::domain_error("MulMatrix: cannot multiply matrices");
+  }
+
+  S21_STATS_OP(S21Op::kMulMatrix, 2.0 * m * n * k);
+  S21BasicMatrix<T> c(m, n);
+
+  for (int begin = 0; begin < m; begin += kCancelBand) {
+    throwIfCancelled(state);
+    s21_gemm(std::min(kCancelBand, m - begin), n, k, a.row(begin),
+             a.getStride(), b.data(), b.getStride(), c.row(begin),
+             c.getStride());
+  }
+
+  return c;
+}
+
+template <typename T>
+S21BasicMatrix<T> invert(const S21BasicMatrix<T>& a,
+                         const S21TaskState& state) {
+  const int n = a.getRows();
+
+  if (n != a.getCols()) {
+    throw std::domain_error("InverseMatrix: matrix must be squared");
+  }
+
+  S21_STATS_OP(S21Op::kInverseMatrix, 2.0 * n * n * n);
+
+  const S21BasicLU<T> lu(a);
+
+  if (lu.IsSingular()) {
+    throw std::domain_error("InverseMatrix: matrix determinant is zero");
+  }
+
+  throwIfCancelled(state);
+
+  return lu.Inverse();
+}
+
+}  // namespace
+
+bool S21TaskState::IsDone() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return done_;
+}
+
+void S21TaskState::Wait() const {
+  std::unique_lock<std::mutex> lock(mutex_);
+  finished_.wait(lock, [this] { return done_; });
+}
+
+bool S21TaskState::OnDone(std::function<void()> continuation) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (done_) {
+    return false;
+  }
+
+  continuations_.push_back(std::move(continuation));
+  return true;
+}
+
+std::exception_ptr S21TaskState::getError() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return error_;
+}
+
+void S21TaskState::Cancel() noexcept { cancelled_.store(true); }
+
+bool S21TaskState::IsCancelled() const noexcept { return cancelled_.load(); }
+
+// Continuations run outside the lock: they schedule dependents, which may
+// finish (and inspect this state) before they return.
+void S21TaskState::Finish(const std::exception_ptr error) {
+  std::vector<std::function<void()>> continuations;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    done_ = true;
+    error_ = error;
+    continuations.swap(continuations_);
+  }
+  finished_.notify_all();
+
+  for (std::function<void()>& continuation : continuations) {
+    continuation();
+  }
+}
+
+// One count per input plus one for this call, so the job is posted exactly
+// once, by whichever thread drops the count to zero.
+void s21_schedule(const std::vector<std::shared_ptr<S21TaskState>>& inputs,
+                  std::function<void()> job) {
+  struct Pending {
+    std::atomic<int> count;
+    std::function<void()> job;
+  };
+
+  auto pending = std::make_shared<Pending>();
+  pending->count.store(static_cast<int>(inputs.size()) + 1);
+  pending->job = std::move(job);
+
+  const auto release = [pending] {
+    if (pending->count.fetch_sub(1) == 1) {
+      s21_get_executor().Post(std::move(pending->job));
+    }
+  };
+
+  for (const std::shared_ptr<S21TaskState>& input : inputs) {
+    if (!input->OnDone(release)) {
+      release();
+    }
+  }
+  release();
+}
+
+template <typename T>
+S21BasicTask<T> s21_mul_matrix_async(const S21BasicTask<T>& a,
+                                     const S21BasicTask<T>& b) {
+  return S21BasicTask<T>::Run(
+      {a.getState(), b.getState()}, [a, b](const S21TaskState& state) {
+        return multiply(a.Get(), b.Get(), state);
+      });
+}
+
+template <typename T>
+S21BasicTask<T> s21_mul_matrix_async(const S21BasicMatrix<T>& a,
+                                     const S21BasicMatrix<T>& b) {
+  return s21_mul_matrix_async(S21BasicTask<T>(a), S21BasicTask<T>(b));
+}
+
+template <typename T>
+S21BasicTask<T> s21_inverse_async(const S21BasicTask<T>& a) {
+  return S21BasicTask<T>::Run({a.getState()},
+                              [a](const S21TaskState& state) {
+                                return invert(a.Get(), state);
+                              });
+}
+
+template <typename T>
+S21BasicTask<T> s21_inverse_async(const S21BasicMatrix<T>& a) {
+  return s21_inverse_async(S21BasicTask<T>(a));
+}
+
+template S21BasicTask<float> s21_mul_matrix_async(const S21BasicTask<float>&,
+                                                  const S21BasicTask<float>&);
+template S21BasicTask<double> s21_mul_matrix_async(
+    const S21BasicTask<double>&, const S21BasicTask<double>&);
+template S21BasicTask<long double> s21_mul_matrix_async(
+    const S21BasicTask<long double>&, const S21BasicTask<long double>&);
+
+template S21BasicTask<float> s21_mul_matrix_async(
+    const S21BasicMatrix<float>&, const S21BasicMatrix<float>&);
+template S21BasicTask<double> s21_mul_matrix_async(
+    const S21BasicMatrix<double>&, const S21BasicMatrix<double>&);
+template S21BasicTask<long double> s21_mul_matrix_async(
+    const S21BasicMatrix<long double>&, const S21BasicMatrix<long double>&);
+
+template S21BasicTask<float> s21_inverse_async(const S21BasicTask<float>&);
+template S21BasicTask<double> s21_inverse_async(const S21BasicTask<double>&);
+template S21BasicTask<long double> s21_inverse_async(
+    const S21BasicTask<long double>&);
+
+template S21BasicTask<float> s21_inverse_async(const S21BasicMatrix<float>&);
+template S21BasicTask<double> s21_inverse_async(const S21BasicMatrix<double>&);
+template S21BasicTask<long double> s21_inverse_async(
+    const S21BasicMatrix<long double>&);
@@ -0,0 +1,242 @@
+#ifndef S21_MATRIX_ASYNC_H_
+#define S21_MATRIX_ASYNC_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Thrown by S21BasicTask::Get for a task cancelled before it finished, and
+// for every task that depends on it.
+class S21TaskCancelled : public std::runtime_error {
+ public:
+  S21TaskCancelled() : std::runtime_error("Async: task cancelled") {}
+};
+
+// Completion state shared by the handles of a task and the scheduler.
+class S21TaskState {
+ public:
+  S21TaskState() : done_(false), cancelled_(false) {}
+  S21TaskState(const S21TaskState&) = delete;
+  S21TaskState& operator=(const S21TaskState&) = delete;
+  virtual ~S21TaskState() = default;
+
+  bool IsDone() const;
+  void Wait() const;
+  // Calls continuation on the thread that finishes the task. Returns false,
+  // without keeping it, if the task is already done.
+  bool OnDone(std::function<void()> continuation);
+  // The exception the task finished with, nullptr on success.
+  std::exception_ptr getError() const;
+
+  void Cancel() noexcept;
+  bool IsCancelled() const noexcept;
+
+  void Finish(const std::exception_ptr error);
+
+ private:
+  mutable std::mutex mutex_;
+  mutable std::condition_variable finished_;
+  bool done_;
+  std::exception_ptr error_;
+  std::vector<std::function<void()>> continuations_;
+  std::atomic<bool> cancelled_;
+};
+
+// Posts job to the library executor (S21Executor::Post) once every input
+// is done. Jobs never wait for each other, so a graph of any depth runs on
+// any number of threads without deadlock.
+void s21_schedule(const std::vector<std::shared_ptr<S21TaskState>>& inputs,
+                  std::function<void()> job);
+
+// Handle to a matrix computed in the background; copies share the result.
+// It is also an awaitable (await_ready, await_suspend, await_resume), so a
+// C++20 coroutine can co_await it. S21TaskState::Finish runs continuations
+// inline, so the coroutine resumes on the thread that finished the task,
+// usually an executor thread, and holds it until it next suspends or ends.
+template <typename T>
+class S21BasicTask {
+ public:
+  using matrix_type = S21BasicMatrix<T>;
+
+  // An already finished task holding value, to feed a matrix into a graph.
+  explicit S21BasicTask(matrix_type value);
+
+  // Runs function(state) on the executor once every input is done, unless
+  // an input failed (the task fails with the same exception) or the task
+  // was cancelled. Long operations may poll state.IsCancelled() and throw
+  // S21TaskCancelled to stop early.
+  template <typename Function>
+  static S21BasicTask Run(
+      const std::vector<std::shared_ptr<S21TaskState>>& inputs,
+      Function function);
+
+  // Accessors
+  std::shared_ptr<S21TaskState> getState() const noexcept;
+
+  // Functions
+  bool IsReady() const;
+  void Wait() const;
+  // Waits, then returns the result or rethrows the task's exception.
+  const matrix_type& Get() const;
+  // Best effort: a task that has not started yet is skipped, a running
+  // product stops at its next row band, anything else completes.
+  void Cancel() noexcept;
+  bool IsCancelled() const noexcept;
+
+  // Awaitable
+  bool await_ready() const;
+  template <typename Handle>
+  bool await_suspend(Handle handle) const;
+  const matrix_type& await_resume() const;
+
+ private:
+  struct State : S21TaskState {
+    matrix_type value;
+  };
+
+  std::shared_ptr<State> state_;
+
+  explicit S21BasicTask(std::shared_ptr<State> state) noexcept;
+};
+
+using S21Task = S21BasicTask<double>;
+
+template <typename T>
+S21BasicTask<T>::S21BasicTask(matrix_type value)
+    : state_(std::make_shared<State>()) {
+  state_->value = std::move(value);
+  state_->Finish(nullptr);
+}
+
+template <typename T>
+S21BasicTask<T>::S21BasicTask(std::shared_ptr<State> state) noexcept
+    : state_(std::move(state)) {}
+
+template <typename T>
+template <typename Function>
+S21BasicTask<T> S21BasicTask<T>::Run(
+    const std::vector<std::shared_ptr<S21TaskState>>& inputs,
+    Function function) {
+  std::shared_ptr<State> state = std::make_shared<State>();
+
+  s21_schedule(inputs, [state, inputs, function]() mutable {
+    std::exception_ptr error;
+    for (const std::shared_ptr<S21TaskState>& input : inputs) {
+      if (!error) {
+        error = input->getError();
+      }
+    }
+
+    if (!error && state->IsCancelled()) {
+      error = std::make_exception_ptr(S21TaskCancelled());
+    }
+
+    if (!error) {
+      try {
+        state->value = function(static_cast<const S21TaskState&>(*state));
+      } catch (...) {
+        error = std::current_exception();
+      }
+    }
+
+    state->Finish(error);
+  });
+
+  return S21BasicTask(std::move(state));
+}
+
+template <typename T>
+std::shared_ptr<S21TaskState> S21BasicTask<T>::getState() const noexcept {
+  return state_;
+}
+
+template <typename T>
+bool S21BasicTask<T>::IsReady() const {
+  return state_->IsDone();
+}
+
+template <typename T>
+void S21BasicTask<T>::Wait() const {
+  state_->Wait();
+}
+
+template <typename T>
+const S21BasicMatrix<T>& S21BasicTask<T>::Get() const {
+  state_->Wait();
+
+  const std::exception_ptr error = state_->getError();
+  if (error) {
+    std::rethrow_exception(error);
+  }
+
+  return state_->value;
+}
+
+template <typename T>
+void S21BasicTask<T>::Cancel() noexcept {
+  state_->Cancel();
+}
+
+template <typename T>
+bool S21BasicTask<T>::IsCancelled() const noexcept {
+  return state_->IsCancelled();
+}
+
+template <typename T>
+bool S21BasicTask<T>::await_ready() const {
+  return state_->IsDone();
+}
+
+template <typename T>
+template <typename Handle>
+bool S21BasicTask<T>::await_suspend(Handle handle) const {
+  return state_->OnDone([handle]() mutable { handle.resume(); });
+}
+
+template <typename T>
+const S21BasicMatrix<T>& S21BasicTask<T>::await_resume() const {
+  return Get();
+}
+
+// function(input.Get()) once input is done.
+template <typename T, typename Function>
+S21BasicTask<T> s21_then(const S21BasicTask<T>& input, Function function) {
+  return S21BasicTask<T>::Run(
+      {input.getState()},
+      [input, function](const S21TaskState&) { return function(input.Get()); });
+}
+
+// function(a.Get(), b.Get()) once both are done.
+template <typename T, typename Function>
+S21BasicTask<T> s21_then(const S21BasicTask<T>& a, const S21BasicTask<T>& b,
+                         Function function) {
+  return S21BasicTask<T>::Run(
+      {a.getState(), b.getState()}, [a, b, function](const S21TaskState&) {
+        return function(a.Get(), b.Get());
+      });
+}
+
+// A * B in the background, in row bands so that Cancel stops it midway.
+// Dimension errors surface from Get, like any other failure.
+template <typename T>
+S21BasicTask<T> s21_mul_matrix_async(const S21BasicTask<T>& a,
+                                     const S21BasicTask<T>& b);
+template <typename T>
+S21BasicTask<T> s21_mul_matrix_async(const S21BasicMatrix<T>& a,
+                                     const S21BasicMatrix<T>& b);
+
+// A^-1 in the background, see InverseMatrix.
+template <typename T>
+S21BasicTask<T> s21_inverse_async(const S21BasicTask<T>& a);
+template <typename T>
+S21BasicTask<T> s21_inverse_async(const S21BasicMatrix<T>& a);
+
+#endif  // S21_MATRIX_ASYNC_H_
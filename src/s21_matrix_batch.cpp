@@ -0,0 +1,407 @@
+#include "s21_matrix_batch.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "s21_matrix_parallel.h"
+
+namespace {
+
+// Matrices per task are sized so that a task's working set, a few n x n
+// planes of the chunk, stays in L2.
+constexpr std::size_t kChunkBytes = 128 * 1024;
+constexpr int kLanes = S21Allocator::kAlignment / sizeof(double);
+
+// Partial-pivoting elimination of a chunk of square matrices stored as
+// w[(i * n + j) * lanes + l]. Every step is a loop over the lanes, which the
+// compiler vectorizes; only row swaps touch single lanes. When inv is set
+// the chunk is reduced Gauss-Jordan style and inv receives the inverses,
+// otherwise det receives the determinants. Returns false if any lane below
+// valid has a negligible pivot by the S21LU rule: at most kEps times the
+// largest element of its column in the input.
+bool eliminate(double* w, double* inv, double* det, const int n,
+               const int lanes, const int valid) {
+  std::vector<double> best(lanes), scale(lanes), factor(lanes);
+  std::vector<double> norm(static_cast<std::size_t>(n) * lanes);
+  std::vector<int> pivot(lanes);
+  bool regular = true;
+
+  auto at = [&](double* base, const int i, const int j) {
+    return base + static_cast<std::size_t>(i * n + j) * lanes;
+  };
+
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      const double* src = at(w, i, j);
+      double* dst = norm.data() + static_cast<std::size_t>(j) * lanes;
+      for (int l = 0; l < lanes; ++l) {
+        dst[l] = std::max(dst[l], fabs(src[l]));
+      }
+    }
+  }
+
+  for (int l = 0; l < lanes; ++l) {
+    det[l] = 1;
+  }
+
+  for (int c = 0; c < n; ++c) {
+    const double* diag = at(w, c, c);
+    for (int l = 0; l < lanes; ++l) {
+      best[l] = fabs(diag[l]);
+      pivot[l] = c;
+    }
+    for (int r = c + 1; r < n; ++r) {
+      const double* col = at(w, r, c);
+      for (int l = 0; l < lanes; ++l) {
+        const double value = fabs(col[l]);
+        const bool larger = value > best[l];
+        best[l] = larger ? value : best[l];
+        pivot[l] = larger ? r : pivot[l];
+      }
+    }
+
+    for (int l = 0; l < lanes; ++l) {
+      const int p = pivot[l];
+      if (p == c) {
+        continue;
+      }
+      det[l] = -det[l];
+      for (int j = inv ? 0 : c; j < n; ++j) {
+        std::swap(at(w, c, j)[l], at(w, p, j)[l]);
+        if (inv) {
+          std::swap(at(inv, c, j)[l], at(inv, p, j)[l]);
+        }
+      }
+    }
+
+    const double* column = norm.data() + static_cast<std::size_t>(c) * lanes;
+    for (int l = 0; l < lanes; ++l) {
+      const double value = diag[l];
+      regular = regular &&
+                ((l >= valid) ||
+                 (best[l] > S21Tolerance<double>::kEps * column[l]));
+      det[l] *= value;
+      scale[l] = value != 0 ? 1 / value : 0;
+    }
+
+    if (inv) {
+      for (int j = 0; j < n; ++j) {
+        double* w_row = at(w, c, j);
+        double* inv_row = at(inv, c, j);
+        for (int l = 0; l < lanes; ++l) {
+          w_row[l] *= scale[l];
+          inv_row[l] *= scale[l];
+        }
+      }
+    }
+
+    for (int r = inv ? 0 : c + 1; r < n; ++r) {
+      if (r == c) {
+        continue;
+      }
+      const double* col = at(w, r, c);
+      for (int l = 0; l < lanes; ++l) {
+        factor[l] = inv ? col[l] : col[l] * scale[l];
+      }
+      for (int j = inv ? 0 : c + 1; j < n; ++j) {
+        double* dst = at(w, r, j);
+        const double* src = at(w, c, j);
+        for (int l = 0; l < lanes; ++l) {
+          dst[l] -= factor[l] * src[l];
+        }
+        if (inv) {
+          double* inv_dst = at(inv, r, j);
+          const double* inv_src = at(inv, c, j);
+          for (int l = 0; l < lanes; ++l) {
+            inv_dst[l] -= factor[l] * inv_src[l];
+          }
+        }
+      }
+    }
+  }
+
+  return regular;
+}
+
+}  // namespace
+
+S21MatrixBatch::S21MatrixBatch(int count, int rows, int cols) {
+  if (count < 1) {
+    throw std::invalid_argument("Invalid count argument");
+  }
+
+  if (rows < 1) {
+    throw std::invalid_argument("Invalid rows argument");
+  }
+
+  if (cols < 1) {
+    throw std::invalid_argument("Invalid cols argument");
+  }
+
+  allocator_ = &s21_get_allocator();
+  count_ = count;
+  rows_ = rows;
+  cols_ = cols;
+  stride_ = (count_ + kLanes - 1) / kLanes * kLanes;
+  data_ = static_cast<double*>(allocator_->Allocate(bytes()));
+  std::memset(data_, 0, bytes());
+}
+
+S21MatrixBatch::S21MatrixBatch(const S21MatrixBatch& other) {
+  allocator_ = &s21_get_allocator();
+  count_ = other.count_;
+  rows_ = other.rows_;
+  cols_ = other.cols_;
+  stride_ = other.stride_;
+  data_ = static_cast<double*>(allocator_->Allocate(bytes()));
+  std::memcpy(data_, other.data_, bytes());
+}
+
+S21MatrixBatch::S21MatrixBatch(S21MatrixBatch&& other) noexcept {
+  allocator_ = other.allocator_;
+  count_ = other.count_;
+  rows_ = other.rows_;
+  cols_ = other.cols_;
+  stride_ = other.stride_;
+  data_ = other.data_;
+
+  other.count_ = 0;
+  other.rows_ = 0;
+  other.cols_ = 0;
+  other.stride_ = 0;
+  other.data_ = nullptr;
+}
+
+S21MatrixBatch::~S21MatrixBatch() {
+  if (data_) {
+    allocator_->Deallocate(data_, bytes());
+  }
+}
+
+std::size_t S21MatrixBatch::bytes() const noexcept {
+  return sizeof(double) * static_cast<std::size_t>(rows_) * cols_ * stride_;
+}
+
+int S21MatrixBatch::chunk() const noexcept {
+  const std::size_t per_matrix =
+      3 * sizeof(double) * static_cast<std::size_t>(rows_) * cols_;
+  const int lanes = static_cast<int>(kChunkBytes / per_matrix);
+  return std::max(kLanes, lanes / kLanes * kLanes);
+}
+
+int S21MatrixBatch::getCount() const noexcept { return count_; }
+
+int S21MatrixBatch::getRows() const noexcept { return rows_; }
+
+int S21MatrixBatch::getCols() const noexcept { return cols_; }
+
+S21Matrix S21MatrixBatch::Get(const int index) const {
+  if ((index < 0) || (index > count_ - 1)) {
+    throw std::out_of_range("index argument out of range");
+  }
+
+  S21Matrix res(rows_, cols_);
+  for (int i = 0; i < rows_; ++i) {
+    for (int j = 0; j < cols_; ++j) {
+      res(i, j) = plane(i, j)[index];
+    }
+  }
+
+  return res;
+}
+
+void S21MatrixBatch::Set(const int index, const S21Matrix& matrix) {
+  if ((index < 0) || (index > count_ - 1)) {
+    throw std::out_of_range("index argument out of range");
+  }
+
+  if ((matrix.getRows() != rows_) || (matrix.getCols() != cols_)) {
+    throw std::invalid_argument("Set: different dimensions");
+  }
+
+  for (int i = 0; i < rows_; ++i) {
+    for (int j = 0; j < cols_; ++j) {
+      plane(i, j)[index] = matrix(i, j);
+    }
+  }
+}
+
+std::vector<double> S21MatrixBatch::BatchDeterminant() const {
+  if (rows_ != cols_) {
+    throw std::domain_error("BatchDeterminant: matrix must be squared");
+  }
+
+  const int n = rows_;
+  const int lanes = chunk();
+  const int tasks = (count_ + lanes - 1) / lanes;
+  std::vector<double> res(stride_);
+
+  s21_parallel_rows(tasks, static_cast<long>(lanes) * n * n * n,
+                    [&](int begin, int end) {
+                      std::vector<double> w(static_cast<std::size_t>(n) * n *
+                                            lanes);
+                      for (int t = begin; t < end; ++t) {
+                        const int first = t * lanes;
+                        const int width = std::min(lanes, stride_ - first);
+                        for (int k = 0; k < n * n; ++k) {
+                          std::memcpy(&w[static_cast<std::size_t>(k) * width],
+                                      data_ + k * stride_ + first,
+                                      sizeof(double) * width);
+                        }
+                        eliminate(w.data(), nullptr, &res[first], n, width,
+                                  count_ - first);
+                      }
+                    });
+
+  res.resize(count_);
+  return res;
+}
+
+S21MatrixBatch S21MatrixBatch::BatchInverse() const {
+  if (rows_ != cols_) {
+    throw std::domain_error("BatchInverse: matrix must be squared");
+  }
+
+  const int n = rows_;
+  const int lanes = chunk();
+  const int tasks = (count_ + lanes - 1) / lanes;
+  S21MatrixBatch res(count_, n, n);
+
+  s21_parallel_rows(
+      tasks, 2L * lanes * n * n * n, [&](int begin, int end) {
+        const std::size_t size = static_cast<std::size_t>(n) * n * lanes;
+        std::vector<double> w(size), inv(size), det(lanes);
+        for (int t = begin; t < end; ++t) {
+          const int first = t * lanes;
+          const int width = std::min(lanes, stride_ - first);
+          std::fill(inv.begin(), inv.end(), 0);
+          for (int k = 0; k < n * n; ++k) {
+            std::memcpy(&w[static_cast<std::size_t>(k) * width],
+                        data_ + k * stride_ + first, sizeof(double) * width);
+          }
+          for (int k = 0; k < n; ++k) {
+            std::fill_n(&inv[static_cast<std::size_t>(k * n + k) * width],
+                        width, 1.0);
+          }
+          if (!eliminate(w.data(), inv.data(), det.data(), n, width,
+                         count_ - first)) {
+            throw std::domain_error(
+                "BatchInverse: matrix determinant is zero");
+          }
+          for (int k = 0; k < n * n; ++k) {
+            std::memcpy(res.data_ + k * stride_ + first,
+                        &inv[static_cast<std::size_t>(k) * width],
+                        sizeof(double) * width);
+          }
+        }
+      });
+
+  return res;
+}
+
+S21MatrixBatch S21MatrixBatch::BatchMul(const S21MatrixBatch& other) const {
+  if ((count_ != other.count_) || (cols_ != other.rows_)) {
+    throw std::domain_error("BatchMul: cannot multiply matrices");
+  }
+
+  const int m = rows_, n = other.cols_, k = cols_;
+  const int lanes = chunk();
+  const int tasks = (count_ + lanes - 1) / lanes;
+  S21MatrixBatch res(count_, m, n);
+
+  // The planes are used in place; a task only narrows them to its lanes.
+  s21_parallel_rows(tasks, static_cast<long>(lanes) * m * n * k,
+                    [&](int begin, int end) {
+                      for (int t = begin; t < end; ++t) {
+                        const int first = t * lanes;
+                        const int width = std::min(lanes, stride_ - first);
+                        for (int i = 0; i < m; ++i) {
+                          for (int j = 0; j < n; ++j) {
+                            double* dst = res.plane(i, j) + first;
+                            for (int l0 = 0; l0 < width; l0 += kLanes) {
+                              double acc[kLanes] = {};
+                              for (int p = 0; p < k; ++p) {
+                                const double* a = plane(i, p) + first + l0;
+                                const double* b =
+                                    other.plane(p, j) + first + l0;
+                                for (int l = 0; l < kLanes; ++l) {
+                                  acc[l] += a[l] * b[l];
+                                }
+                              }
+                              std::memcpy(dst + l0, acc, sizeof(acc));
+                            }
+                          }
+                        }
+                      }
+                    });
+
+  return res;
+}
+
+S21MatrixBatch& S21MatrixBatch::operator=(const S21MatrixBatch& other) {
+  if (this != &other) {
+    *this = S21MatrixBatch(other);
+  }
+
+  return *this;
+}
+
+S21MatrixBatch& S21MatrixBatch::operator=(S21MatrixBatch&& other) noexcept {
+  if (this == &other) {
+    return *this;
+  }
+
+  if (data_) {
+    allocator_->Deallocate(data_, bytes());
+  }
+
+  allocator_ = other.allocator_;
+  count_ = other.count_;
+  rows_ = other.rows_;
+  cols_ = other.cols_;
+  stride_ = other.stride_;
+  data_ = other.data_;
+
+  other.count_ = 0;
+  other.rows_ = 0;
+  other.cols_ = 0;
+  other.stride_ = 0;
+  other.data_ = nullptr;
+
+  return *this;
+}
+
+double& S21MatrixBatch::operator()(const int index, const int i,
+                                   const int j) {
+  if ((index < 0) || (index > count_ - 1)) {
+    throw std::out_of_range("index argument out of range");
+  }
+
+  if ((i < 0) || (i > rows_ - 1)) {
+    throw std::out_of_range("i argument out of range");
+  }
+
+  if ((j < 0) || (j > cols_ - 1)) {
+    throw std::out_of_range("j argument out of range");
+  }
+
+  return plane(i, j)[index];
+}
+
+double S21MatrixBatch::operator()(const int index, const int i,
+                                  const int j) const {
+  if ((index < 0) || (index > count_ - 1)) {
+    throw std::out_of_range("index argument out of range");
+  }
+
+  if ((i < 0) || (i > rows_ - 1)) {
+    throw std::out_of_range("i argument out of range");
+  }
+
+  if ((j < 0) || (j > cols_ - 1)) {
+    throw std::out_of_range("j argument out of range");
+  }
+
+  return plane(i, j)[index];
+}
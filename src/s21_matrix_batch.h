@@ -0,0 +1,53 @@
+#ifndef S21_MATRIX_BATCH_H_
+#define S21_MATRIX_BATCH_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// A batch of same-shaped small matrices in structure-of-arrays layout:
+// element (i, j) of every matrix lives in one contiguous plane, so the batch
+// operations run the same arithmetic across neighbouring matrices in SIMD
+// lanes and split the batch between threads.
+class S21MatrixBatch {
+ public:
+  // Constructors
+  S21MatrixBatch(int count, int rows, int cols);
+  S21MatrixBatch(const S21MatrixBatch& other);
+  S21MatrixBatch(S21MatrixBatch&& other) noexcept;
+  ~S21MatrixBatch();
+
+  // Accessors
+  int getCount() const noexcept;
+  int getRows() const noexcept;
+  int getCols() const noexcept;
+
+  // Functions
+  S21Matrix Get(const int index) const;
+  void Set(const int index, const S21Matrix& matrix);
+  std::vector<double> BatchDeterminant() const;
+  S21MatrixBatch BatchInverse() const;
+  S21MatrixBatch BatchMul(const S21MatrixBatch& other) const;
+
+  // Operators
+  S21MatrixBatch& operator=(const S21MatrixBatch& other);
+  S21MatrixBatch& operator=(S21MatrixBatch&& other) noexcept;
+  double& operator()(const int index, const int i, const int j);
+  double operator()(const int index, const int i, const int j) const;
+
+ private:
+  int count_, rows_, cols_;
+  // Distance between planes, count_ rounded up to a whole cache line.
+  int stride_;
+  double* data_;
+  S21Allocator* allocator_;
+
+  double* plane(const int i, const int j) const noexcept {
+    return data_ + static_cast<std::size_t>(i * cols_ + j) * stride_;
+  }
+  std::size_t bytes() const noexcept;
+  // Number of matrices processed together by one task.
+  int chunk() const noexcept;
+};
+
+#endif  // S21_MATRIX_BATCH_H_
@@ -0,0 +1,140 @@
+#include "s21_matrix_cholesky.h"
+
+template <typename T>
+S21BasicCholesky<T>::S21BasicCholesky(const S21BasicMatrix<T>& matrix)
+    : r_(matrix), positive_(true) {
+  if (matrix.getRows() != matrix.getCols()) {
+    throw std::domain_error("S21Cholesky: matrix must be squared");
+  }
+
+  const int n = r_.getRows();
+
+  for (int k = 0; k < n; ++k) {
+    T* row_k = r_.row(k);
+    for (int j = 0; j < k; ++j) {
+      row_k[j] = 0;
+    }
+
+    // Equal to the LU pivot, up to a factor, only when it is positive. It
+    // is measured against sqrt(a_kk), the norm of column k of R, so
+    // scaling A symmetrically never changes the verdict.
+    if (!(row_k[k] > 0) ||
+        (std::sqrt(row_k[k]) <=
+         S21Tolerance<T>::kEps * std::sqrt(matrix.at_unchecked(k, k)))) {
+      positive_ = false;
+      return;
+    }
+
+    const T pivot = std::sqrt(row_k[k]);
+    const T inv = 1 / pivot;
+    row_k[k] = pivot;
+    for (int j = k + 1; j < n; ++j) {
+      row_k[j] *= inv;
+    }
+
+    // The trailing upper triangle loses the outer product of row k.
+    for (int i = k + 1; i < n; ++i) {
+      const T r = row_k[i];
+      if (r == 0) {
+        continue;
+      }
+      T* row_i = r_.row(i);
+      for (int j = i; j < n; ++j) {
+        row_i[j] -= r * row_k[j];
+      }
+    }
+  }
+}
+
+template <typename T>
+int S21BasicCholesky<T>::getSize() const noexcept { return r_.getRows(); }
+
+template <typename T>
+const S21BasicMatrix<T>& S21BasicCholesky<T>::getR() const noexcept {
+  return r_;
+}
+
+template <typename T>
+bool S21BasicCholesky<T>::IsPositiveDefinite() const noexcept {
+  return positive_;
+}
+
+template <typename T>
+T S21BasicCholesky<T>::Determinant() const noexcept {
+  if (!positive_) {
+    return 0;
+  }
+
+  T det = 1;
+  for (int i = 0; i < r_.getRows(); ++i) {
+    det *= r_.at_unchecked(i, i);
+  }
+
+  return det * det;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicCholesky<T>::Solve(
+    const S21BasicMatrix<T>& b) const {
+  S21BasicMatrix<T> x(b);
+  SolveInPlace(x);
+  return x;
+}
+
+// R^T * Y = B, then R * X = Y, on whole rows of B like S21LU.
+template <typename T>
+void S21BasicCholesky<T>::SolveInPlace(S21BasicMatrix<T>& b) const {
+  const int n = r_.getRows();
+
+  if (b.getRows() != n) {
+    throw std::invalid_argument("S21Cholesky: different dimensions");
+  }
+
+  if (!positive_) {
+    throw std::domain_error("S21Cholesky: matrix is not positive definite");
+  }
+
+  const int m = b.getCols();
+
+  for (int i = 0; i < n; ++i) {
+    const T* r_i = r_.row(i);
+    T* row_i = b.row(i);
+    const T inv = 1 / r_i[i];
+    for (int j = 0; j < m; ++j) {
+      row_i[j] *= inv;
+    }
+    for (int k = i + 1; k < n; ++k) {
+      const T r = r_i[k];
+      if (r == 0) {
+        continue;
+      }
+      T* row_k = b.row(k);
+      for (int j = 0; j < m; ++j) {
+        row_k[j] -= r * row_i[j];
+      }
+    }
+  }
+
+  for (int i = n - 1; i >= 0; --i) {
+    const T* r_i = r_.row(i);
+    T* row_i = b.row(i);
+    for (int k = i + 1; k < n; ++k) {
+      const T r = r_i[k];
+      if (r == 0) {
+        continue;
+      }
+      const T* row_k = b.row(k);
+      for (int j = 0; j < m; ++j) {
+        row_i[j] -= r * row_k[j];
+      }
+    }
+    const T inv = 1 / r_i[i];
+    for (int j = 0; j < m; ++j) {
+      row_i[j] *= inv;
+    }
+  }
+}
+
+template class S21BasicCholesky<float>;
+template class S21BasicCholesky<double>;
+template class S21BasicCholesky<long double>;
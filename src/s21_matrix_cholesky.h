@@ -0,0 +1,42 @@
+#ifndef S21_MATRIX_CHOLESKY_H_
+#define S21_MATRIX_CHOLESKY_H_
+
+#include "s21_matrix_oop.h"
+
+// Cholesky factorization of a symmetric positive definite matrix:
+// A = R^T * R with R upper triangular. Only the upper triangle of A is
+// read, and every update is a contiguous row operation. Half the work of
+// S21LU and no pivoting; a matrix that is not positive definite (to
+// working precision) is reported by IsPositiveDefinite() instead of
+// throwing, so callers can fall back to S21LU.
+template <typename T>
+class S21BasicCholesky {
+ public:
+  explicit S21BasicCholesky(const S21BasicMatrix<T>& matrix);
+
+  // Accessors
+  int getSize() const noexcept;
+  // R, with zeros below the diagonal.
+  const S21BasicMatrix<T>& getR() const noexcept;
+
+  // Functions
+  bool IsPositiveDefinite() const noexcept;
+  T Determinant() const noexcept;
+
+  // A * X = B for every column of B, O(n^2) per column. SolveInPlace
+  // overwrites B with X and allocates nothing.
+  S21BasicMatrix<T> Solve(const S21BasicMatrix<T>& b) const;
+  void SolveInPlace(S21BasicMatrix<T>& b) const;
+
+ private:
+  S21BasicMatrix<T> r_;
+  bool positive_;
+};
+
+using S21Cholesky = S21BasicCholesky<double>;
+
+extern template class S21BasicCholesky<float>;
+extern template class S21BasicCholesky<double>;
+extern template class S21BasicCholesky<long double>;
+
+#endif  // S21_MATRIX_CHOLESKY_H_
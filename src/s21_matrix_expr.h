@@ -0,0 +1,385 @@
+#ifndef S21_MATRIX_EXPR_H_
+#define S21_MATRIX_EXPR_H_
+
+// Lazy element-wise expressions over S21BasicMatrix. Included at the end of
+// s21_matrix_oop.h; do not include it directly.
+//
+// a + b * 2.0 - c builds a small tree of nodes instead of temporaries. The
+// tree is evaluated in one fused loop when it is assigned to or used to
+// construct an S21Matrix. Nodes refer to their matrix operands, so do not
+// keep an expression (e.g. in an auto variable) past the operands'
+// lifetime, and note that it sees later changes to them; convert it to
+// S21Matrix or call Eval() instead. Expressions also offer the read-only
+// part of the S21Matrix interface (element access, dimensions, EqMatrix,
+// ==, Transpose, CalcComplements, Determinant, InverseMatrix, Minor).
+//
+// All operands of an expression share one element type; numbers are
+// converted to it, so float_matrix * 2.0 stays a float expression.
+
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "s21_matrix_parallel.h"
+#include "s21_matrix_stats.h"
+
+// Reads a matrix operand in place.
+template <typename T>
+class S21ExprLeaf {
+ public:
+  using value_type = T;
+
+  explicit S21ExprLeaf(const S21BasicMatrix<T>& matrix) noexcept
+      : data_(matrix.matrix_),
+        rows_(matrix.rows_),
+        cols_(matrix.cols_),
+        stride_(matrix.stride_) {}
+
+  int getRows() const noexcept { return rows_; }
+  int getCols() const noexcept { return cols_; }
+  T At(const int i, const int j) const noexcept {
+    return data_[i * stride_ + j];
+  }
+
+  // A leaf reads each element at the position being written, so it never
+  // conflicts with evaluation into its own matrix.
+  bool Overlaps(const T*, const T*) const noexcept { return false; }
+
+ private:
+  const T* data_;
+  int rows_, cols_, stride_;
+};
+
+template <typename Derived>
+class S21Expr : public S21ExprTag {
+ public:
+  int getRows() const noexcept { return self().getRows(); }
+  int getCols() const noexcept { return self().getCols(); }
+  // Deferred so that Derived is complete when value_type is looked up.
+  template <typename D = Derived>
+  S21BasicMatrix<typename D::value_type> Eval() const {
+    return S21BasicMatrix<typename D::value_type>(self());
+  }
+
+  // The read-only S21Matrix interface, so that (a + b)(0, 0) or
+  // (a - b).Determinant() still compile: elements are read in place, the
+  // other functions work on Eval().
+  template <typename D = Derived>
+  typename D::value_type operator()(const int i, const int j) const {
+    if ((i < 0) || (i > getRows() - 1)) {
+      throw std::out_of_range("i argument out of range");
+    }
+
+    if ((j < 0) || (j > getCols() - 1)) {
+      throw std::out_of_range("j argument out of range");
+    }
+
+    return self().At(i, j);
+  }
+  template <typename D = Derived>
+  bool EqMatrix(const S21BasicMatrix<typename D::value_type>& other) const {
+    return Eval().EqMatrix(other);
+  }
+  template <typename D = Derived>
+  bool operator==(const S21BasicMatrix<typename D::value_type>& other) const {
+    return Eval() == other;
+  }
+  template <typename D = Derived>
+  S21BasicMatrix<typename D::value_type> Transpose() const {
+    return Eval().Transpose();
+  }
+  template <typename D = Derived>
+  S21BasicMatrix<typename D::value_type> CalcComplements() const {
+    return Eval().CalcComplements();
+  }
+  template <typename D = Derived>
+  typename D::value_type Determinant() const {
+    return Eval().Determinant();
+  }
+  template <typename D = Derived>
+  S21BasicMatrix<typename D::value_type> InverseMatrix() const {
+    return Eval().InverseMatrix();
+  }
+  template <typename D = Derived>
+  S21BasicMatrix<typename D::value_type> Minor(const int i,
+                                               const int j) const {
+    return Eval().Minor(i, j);
+  }
+
+ private:
+  const Derived& self() const noexcept {
+    return static_cast<const Derived&>(*this);
+  }
+};
+
+// Maps an operand type to the type stored inside a node.
+template <typename T>
+struct S21ExprOperand {
+  using type = T;
+  static const T& Wrap(const T& expr) noexcept { return expr; }
+};
+
+template <typename T>
+struct S21ExprOperand<S21BasicMatrix<T>> {
+  using type = S21ExprLeaf<T>;
+  static S21ExprLeaf<T> Wrap(const S21BasicMatrix<T>& matrix) noexcept {
+    return S21ExprLeaf<T>(matrix);
+  }
+};
+
+// Element type of an operand; numbers multiplying it are converted to this.
+template <typename T>
+using S21ExprValue = typename S21ExprOperand<T>::type::value_type;
+
+template <typename T>
+struct S21IsMatrix : std::false_type {};
+
+template <typename T>
+struct S21IsMatrix<S21BasicMatrix<T>> : std::true_type {};
+
+template <typename T>
+struct S21IsExprOperand
+    : std::integral_constant<bool, std::is_base_of<S21ExprTag, T>::value ||
+                                       S21IsMatrix<T>::value> {};
+
+struct S21PlusOp {
+  template <typename T>
+  static T Apply(const T a, const T b) noexcept {
+    return a + b;
+  }
+};
+
+struct S21MinusOp {
+  template <typename T>
+  static T Apply(const T a, const T b) noexcept {
+    return a - b;
+  }
+};
+
+template <typename L, typename R, typename Op>
+class S21BinaryExpr : public S21Expr<S21BinaryExpr<L, R, Op>> {
+  static_assert(std::is_same<typename L::value_type,
+                             typename R::value_type>::value,
+                "S21Matrix: operands of different element types");
+
+ public:
+  using value_type = typename L::value_type;
+
+  S21BinaryExpr(const L& lhs, const R& rhs) : lhs_(lhs), rhs_(rhs) {
+    if ((lhs_.getRows() != rhs_.getRows()) ||
+        (lhs_.getCols() != rhs_.getCols())) {
+      throw std::invalid_argument("S21Matrix: different dimensions");
+    }
+  }
+
+  int getRows() const noexcept { return lhs_.getRows(); }
+  int getCols() const noexcept { return lhs_.getCols(); }
+  value_type At(const int i, const int j) const noexcept {
+    return Op::Apply(lhs_.At(i, j), rhs_.At(i, j));
+  }
+
+  bool Overlaps(const value_type* begin,
+                const value_type* end) const noexcept {
+    return lhs_.Overlaps(begin, end) || rhs_.Overlaps(begin, end);
+  }
+
+ private:
+  L lhs_;
+  R rhs_;
+};
+
+template <typename E>
+class S21ScaleExpr : public S21Expr<S21ScaleExpr<E>> {
+ public:
+  using value_type = typename E::value_type;
+
+  S21ScaleExpr(const E& expr, const value_type num) noexcept
+      : expr_(expr), num_(num) {}
+
+  int getRows() const noexcept { return expr_.getRows(); }
+  int getCols() const noexcept { return expr_.getCols(); }
+  value_type At(const int i, const int j) const noexcept {
+    return expr_.At(i, j) * num_;
+  }
+
+  bool Overlaps(const value_type* begin,
+                const value_type* end) const noexcept {
+    return expr_.Overlaps(begin, end);
+  }
+
+ private:
+  E expr_;
+  value_type num_;
+};
+
+template <typename L, typename R>
+using S21SumExpr =
+    S21BinaryExpr<typename S21ExprOperand<L>::type,
+                  typename S21ExprOperand<R>::type, S21PlusOp>;
+
+template <typename L, typename R>
+using S21SubExpr =
+    S21BinaryExpr<typename S21ExprOperand<L>::type,
+                  typename S21ExprOperand<R>::type, S21MinusOp>;
+
+template <typename E>
+using S21MulNumberExpr = S21ScaleExpr<typename S21ExprOperand<E>::type>;
+
+// Operators
+
+template <typename L, typename R,
+          typename = std::enable_if_t<S21IsExprOperand<L>::value &&
+                                      S21IsExprOperand<R>::value>>
+S21SumExpr<L, R> operator+(const L& lhs, const R& rhs) {
+  return S21SumExpr<L, R>(S21ExprOperand<L>::Wrap(lhs),
+                          S21ExprOperand<R>::Wrap(rhs));
+}
+
+template <typename L, typename R,
+          typename = std::enable_if_t<S21IsExprOperand<L>::value &&
+                                      S21IsExprOperand<R>::value>>
+S21SubExpr<L, R> operator-(const L& lhs, const R& rhs) {
+  return S21SubExpr<L, R>(S21ExprOperand<L>::Wrap(lhs),
+                          S21ExprOperand<R>::Wrap(rhs));
+}
+
+template <typename E,
+          typename = std::enable_if_t<S21IsExprOperand<E>::value>>
+S21MulNumberExpr<E> operator*(const E& expr,
+                              const S21ExprValue<E>& num) noexcept {
+  return S21MulNumberExpr<E>(S21ExprOperand<E>::Wrap(expr), num);
+}
+
+template <typename E,
+          typename = std::enable_if_t<S21IsExprOperand<E>::value>>
+S21MulNumberExpr<E> operator*(const S21ExprValue<E>& num,
+                              const E& expr) noexcept {
+  return S21MulNumberExpr<E>(S21ExprOperand<E>::Wrap(expr), num);
+}
+
+// An expiring matrix operand lends its buffer to the result instead of
+// being read into a new one.
+
+template <typename T, typename R,
+          typename = std::enable_if_t<S21IsExprOperand<R>::value>>
+S21BasicMatrix<T> operator+(S21BasicMatrix<T>&& lhs, const R& rhs) {
+  lhs += rhs;
+  return std::move(lhs);
+}
+
+template <typename L, typename T,
+          typename = std::enable_if_t<S21IsExprOperand<L>::value>>
+S21BasicMatrix<T> operator+(const L& lhs, S21BasicMatrix<T>&& rhs) {
+  rhs += lhs;
+  return std::move(rhs);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator+(S21BasicMatrix<T>&& lhs,
+                            S21BasicMatrix<T>&& rhs) {
+  lhs += rhs;
+  return std::move(lhs);
+}
+
+template <typename T, typename R,
+          typename = std::enable_if_t<S21IsExprOperand<R>::value>>
+S21BasicMatrix<T> operator-(S21BasicMatrix<T>&& lhs, const R& rhs) {
+  lhs -= rhs;
+  return std::move(lhs);
+}
+
+template <typename L, typename T,
+          typename = std::enable_if_t<S21IsExprOperand<L>::value>>
+S21BasicMatrix<T> operator-(const L& lhs, S21BasicMatrix<T>&& rhs) {
+  rhs = S21SubExpr<L, S21BasicMatrix<T>>(S21ExprOperand<L>::Wrap(lhs),
+                                         S21ExprLeaf<T>(rhs));
+  return std::move(rhs);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator-(S21BasicMatrix<T>&& lhs,
+                            S21BasicMatrix<T>&& rhs) {
+  lhs -= rhs;
+  return std::move(lhs);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator*(
+    S21BasicMatrix<T>&& matrix,
+    const typename S21BasicMatrix<T>::value_type& num) noexcept {
+  matrix *= num;
+  return std::move(matrix);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator*(
+    const typename S21BasicMatrix<T>::value_type& num,
+    S21BasicMatrix<T>&& matrix) noexcept {
+  matrix *= num;
+  return std::move(matrix);
+}
+
+// Matrix products are not element-wise: lazy operands are evaluated first.
+template <typename L, typename R,
+          typename = std::enable_if_t<
+              S21IsExprOperand<L>::value && S21IsExprOperand<R>::value &&
+              (std::is_base_of<S21ExprTag, L>::value ||
+               std::is_base_of<S21ExprTag, R>::value)>>
+S21BasicMatrix<S21ExprValue<L>> operator*(const L& lhs, const R& rhs) {
+  S21BasicMatrix<S21ExprValue<L>> res(lhs);
+  res.MulMatrix(S21BasicMatrix<S21ExprValue<R>>(rhs));
+  return res;
+}
+
+// S21BasicMatrix members taking expressions
+
+template <typename T>
+template <typename E, typename>
+S21BasicMatrix<T>::S21BasicMatrix(const E& expr)
+    : S21BasicMatrix(expr.getRows(), expr.getCols()) {
+  assignExpr(expr);
+}
+
+template <typename T>
+template <typename E, typename>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(const E& expr) {
+  if ((rows_ == expr.getRows()) && (cols_ == expr.getCols()) && matrix_ &&
+      !expr.Overlaps(matrix_, matrix_ + rows_ * stride_)) {
+    // Apart from views, every element depends only on operand elements at
+    // the same position, so evaluating into an operand is safe.
+    assignExpr(expr);
+  } else {
+    *this = S21BasicMatrix(expr);
+  }
+  return *this;
+}
+
+template <typename T>
+template <typename E, typename>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator+=(const E& expr) {
+  return *this = *this + expr;
+}
+
+template <typename T>
+template <typename E, typename>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator-=(const E& expr) {
+  return *this = *this - expr;
+}
+
+template <typename T>
+template <typename E>
+void S21BasicMatrix<T>::assignExpr(const E& expr) {
+  S21_STATS_OP(S21Op::kExpression, 0);
+  s21_parallel_rows(rows_, cols_, [&](int begin, int end) {
+    // A local copy lets the compiler keep operand pointers in registers.
+    const E node = expr;
+    for (int i = begin; i < end; ++i) {
+      T* row = matrix_ + i * stride_;
+      for (int j = 0; j < cols_; ++j) {
+        row[j] = node.At(i, j);
+      }
+    }
+  });
+}
+
+#endif  // S21_MATRIX_EXPR_H_
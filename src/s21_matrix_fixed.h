@@ -0,0 +1,398 @@
+#ifndef S21_MATRIX_FIXED_H_
+#define S21_MATRIX_FIXED_H_
+
+#include <stdexcept>
+#include <type_traits>
+
+#include "s21_matrix_oop.h"
+
+// Matrix with dimensions fixed at compile time and storage inline in the
+// object. Mirrors the S21Matrix interface; operand dimensions are checked
+// by the type system, and every function is usable in constant
+// expressions.
+template <int R, int C, typename T = double>
+class S21FixedMatrix {
+  static_assert(R > 0 && C > 0, "S21FixedMatrix: invalid dimensions");
+  static_assert(std::is_floating_point<T>::value,
+                "S21FixedMatrix: element type must be floating point");
+
+  template <int, int, typename>
+  friend class S21FixedMatrix;
+
+ public:
+  using value_type = T;
+
+  // Constructors
+  constexpr S21FixedMatrix() noexcept : matrix_{} {}
+
+  // Row-major list of elements; missing elements are zero.
+  template <typename... Args,
+            typename = std::enable_if_t<
+                (sizeof...(Args) > 0) && (sizeof...(Args) <= R * C) &&
+                std::conjunction<std::is_arithmetic<Args>...>::value>>
+  constexpr explicit S21FixedMatrix(const Args... values) noexcept
+      : matrix_{static_cast<T>(values)...} {}
+
+  template <typename U>
+  explicit S21FixedMatrix(const S21BasicMatrix<U>& other) : matrix_{} {
+    if ((other.getRows() != R) || (other.getCols() != C)) {
+      throw std::invalid_argument("S21FixedMatrix: different dimensions");
+    }
+    for (int i = 0; i < R; ++i) {
+      for (int j = 0; j < C; ++j) {
+        matrix_[i * C + j] = static_cast<T>(other(i, j));
+      }
+    }
+  }
+
+  template <typename U>
+  explicit operator S21BasicMatrix<U>() const {
+    S21BasicMatrix<U> res(R, C);
+    for (int i = 0; i < R; ++i) {
+      for (int j = 0; j < C; ++j) {
+        res(i, j) = static_cast<U>(matrix_[i * C + j]);
+      }
+    }
+    return res;
+  }
+
+  static constexpr S21FixedMatrix Identity() noexcept {
+    static_assert(R == C, "Identity: matrix must be squared");
+    S21FixedMatrix res;
+    for (int i = 0; i < R; ++i) {
+      res.matrix_[i * C + i] = 1;
+    }
+    return res;
+  }
+
+  // Accessors
+  static constexpr int getRows() noexcept { return R; }
+  static constexpr int getCols() noexcept { return C; }
+
+  // Functions
+  constexpr bool EqMatrix(const S21FixedMatrix& other) const noexcept {
+    for (int i = 0; i < R * C; ++i) {
+      if (abs(matrix_[i] - other.matrix_[i]) > S21Tolerance<T>::kEps) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  constexpr void SumMatrix(const S21FixedMatrix& other) noexcept {
+    for (int i = 0; i < R * C; ++i) {
+      matrix_[i] += other.matrix_[i];
+    }
+  }
+
+  constexpr void SubMatrix(const S21FixedMatrix& other) noexcept {
+    for (int i = 0; i < R * C; ++i) {
+      matrix_[i] -= other.matrix_[i];
+    }
+  }
+
+  constexpr void MulNumber(const T num) noexcept {
+    for (int i = 0; i < R * C; ++i) {
+      matrix_[i] *= num;
+    }
+  }
+
+  // In-place product keeps the type, so it needs a square right operand.
+  constexpr void MulMatrix(const S21FixedMatrix<C, C, T>& other) noexcept {
+    *this = *this * other;
+  }
+
+  constexpr S21FixedMatrix<C, R, T> Transpose() const noexcept {
+    S21FixedMatrix<C, R, T> res;
+    for (int i = 0; i < R; ++i) {
+      for (int j = 0; j < C; ++j) {
+        res.matrix_[j * R + i] = matrix_[i * C + j];
+      }
+    }
+    return res;
+  }
+
+  constexpr S21FixedMatrix<R - 1, C - 1, T> Minor(const int i,
+                                                  const int j) const {
+    static_assert(R > 1 && C > 1, "Minor: matrix is too small");
+    if ((i < 0) || (i > R - 1)) {
+      throw std::out_of_range("Minor: i argument out of range");
+    }
+    if ((j < 0) || (j > C - 1)) {
+      throw std::out_of_range("Minor: j argument out of range");
+    }
+
+    S21FixedMatrix<R - 1, C - 1, T> minor;
+    for (int m = 0, k = 0; m < R; ++m) {
+      if (m == i) {
+        continue;
+      }
+      for (int n = 0, l = 0; n < C; ++n) {
+        if (n != j) {
+          minor.matrix_[k * (C - 1) + l++] = matrix_[m * C + n];
+        }
+      }
+      ++k;
+    }
+    return minor;
+  }
+
+  constexpr T Determinant() const noexcept {
+    static_assert(R == C, "Determinant: matrix must be squared");
+    if constexpr (R <= kClosedForm) {
+      return cofactorDeterminant();
+    } else {
+      return eliminationDeterminant();
+    }
+  }
+
+  constexpr S21FixedMatrix CalcComplements() const {
+    static_assert(R == C, "CalcComplements: matrix must be squared");
+    S21FixedMatrix res;
+    if constexpr (R == 1) {
+      res.matrix_[0] = 1;
+    } else {
+      for (int i = 0; i < R; ++i) {
+        for (int j = 0; j < C; ++j) {
+          const T sign = ((i + j) % 2) ? -1 : 1;
+          res.matrix_[i * C + j] = sign * Minor(i, j).Determinant();
+        }
+      }
+    }
+    return res;
+  }
+
+  constexpr S21FixedMatrix InverseMatrix() const {
+    static_assert(R == C, "InverseMatrix: matrix must be squared");
+    if constexpr (R <= kClosedForm) {
+      if (isSingular()) {
+        throw std::domain_error("InverseMatrix: matrix determinant is zero");
+      }
+      const T det = Determinant();
+      S21FixedMatrix res = CalcComplements().Transpose();
+      res.MulNumber(1 / det);
+      return res;
+    } else {
+      return gaussJordanInverse();
+    }
+  }
+
+  // Operators
+  constexpr S21FixedMatrix operator+(const S21FixedMatrix& other) const
+      noexcept {
+    S21FixedMatrix res(*this);
+    res.SumMatrix(other);
+    return res;
+  }
+
+  constexpr S21FixedMatrix operator-(const S21FixedMatrix& other) const
+      noexcept {
+    S21FixedMatrix res(*this);
+    res.SubMatrix(other);
+    return res;
+  }
+
+  template <int C2>
+  constexpr S21FixedMatrix<R, C2, T> operator*(
+      const S21FixedMatrix<C, C2, T>& other) const noexcept {
+    S21FixedMatrix<R, C2, T> res;
+    for (int i = 0; i < R; ++i) {
+      for (int k = 0; k < C; ++k) {
+        const T a = matrix_[i * C + k];
+        for (int j = 0; j < C2; ++j) {
+          res.matrix_[i * C2 + j] += a * other.matrix_[k * C2 + j];
+        }
+      }
+    }
+    return res;
+  }
+
+  constexpr S21FixedMatrix operator*(const T num) const noexcept {
+    S21FixedMatrix res(*this);
+    res.MulNumber(num);
+    return res;
+  }
+
+  constexpr bool operator==(const S21FixedMatrix& other) const noexcept {
+    return EqMatrix(other);
+  }
+
+  constexpr S21FixedMatrix& operator+=(const S21FixedMatrix& other) noexcept {
+    SumMatrix(other);
+    return *this;
+  }
+
+  constexpr S21FixedMatrix& operator-=(const S21FixedMatrix& other) noexcept {
+    SubMatrix(other);
+    return *this;
+  }
+
+  constexpr S21FixedMatrix& operator*=(
+      const S21FixedMatrix<C, C, T>& other) noexcept {
+    MulMatrix(other);
+    return *this;
+  }
+
+  constexpr S21FixedMatrix& operator*=(const T num) noexcept {
+    MulNumber(num);
+    return *this;
+  }
+
+  constexpr T operator()(const int i, const int j) const {
+    checkIndex(i, j);
+    return matrix_[i * C + j];
+  }
+
+  constexpr T& operator()(const int i, const int j) {
+    checkIndex(i, j);
+    return matrix_[i * C + j];
+  }
+
+ private:
+  // Determinants up to this size use unrolled cofactor expansion.
+  static constexpr int kClosedForm = 4;
+
+  T matrix_[R * C];
+
+  static constexpr T abs(const T value) noexcept {
+    return value < 0 ? -value : value;
+  }
+
+  static constexpr void checkIndex(const int i, const int j) {
+    if ((i < 0) || (i > R - 1)) {
+      throw std::out_of_range("i argument out of range");
+    }
+    if ((j < 0) || (j > C - 1)) {
+      throw std::out_of_range("j argument out of range");
+    }
+  }
+
+  constexpr T cofactorDeterminant() const noexcept {
+    if constexpr (R == 1) {
+      return matrix_[0];
+    } else if constexpr (R == 2) {
+      return matrix_[0] * matrix_[3] - matrix_[1] * matrix_[2];
+    } else {
+      T det = 0;
+      for (int j = 0; j < C; ++j) {
+        const T sign = (j % 2) ? -1 : 1;
+        det += sign * matrix_[j] * Minor(0, j).Determinant();
+      }
+      return det;
+    }
+  }
+
+  constexpr T eliminationDeterminant() const noexcept {
+    S21FixedMatrix a(*this);
+    T det = 1;
+    for (int k = 0; k < R; ++k) {
+      int p = a.pivotRow(k);
+      if (a.matrix_[p * C + k] == 0) {
+        return 0;
+      }
+      if (p != k) {
+        a.swapRows(p, k);
+        det = -det;
+      }
+      det *= a.matrix_[k * C + k];
+      for (int i = k + 1; i < R; ++i) {
+        const T l = a.matrix_[i * C + k] / a.matrix_[k * C + k];
+        for (int j = k; j < C; ++j) {
+          a.matrix_[i * C + j] -= l * a.matrix_[k * C + j];
+        }
+      }
+    }
+    return det;
+  }
+
+  // The S21LU rule, for every size: a pivot is negligible when it is at
+  // most kEps times the largest element of column k of this matrix.
+  constexpr bool negligible(const T pivot, const int k) const noexcept {
+    T scale = 0;
+    for (int i = 0; i < R; ++i) {
+      const T value = abs(matrix_[i * C + k]);
+      scale = value > scale ? value : scale;
+    }
+    return abs(pivot) <= S21Tolerance<T>::kEps * scale;
+  }
+
+  constexpr bool isSingular() const noexcept {
+    S21FixedMatrix a(*this);
+    for (int k = 0; k < R; ++k) {
+      const int p = a.pivotRow(k);
+      if (negligible(a.matrix_[p * C + k], k)) {
+        return true;
+      }
+      a.swapRows(p, k);
+      for (int i = k + 1; i < R; ++i) {
+        const T l = a.matrix_[i * C + k] / a.matrix_[k * C + k];
+        for (int j = k; j < C; ++j) {
+          a.matrix_[i * C + j] -= l * a.matrix_[k * C + j];
+        }
+      }
+    }
+    return false;
+  }
+
+  constexpr S21FixedMatrix gaussJordanInverse() const {
+    S21FixedMatrix a(*this);
+    S21FixedMatrix res = Identity();
+    for (int k = 0; k < R; ++k) {
+      int p = a.pivotRow(k);
+      if (negligible(a.matrix_[p * C + k], k)) {
+        throw std::domain_error("InverseMatrix: matrix determinant is zero");
+      }
+      if (p != k) {
+        a.swapRows(p, k);
+        res.swapRows(p, k);
+      }
+      const T inv = 1 / a.matrix_[k * C + k];
+      for (int j = 0; j < C; ++j) {
+        a.matrix_[k * C + j] *= inv;
+        res.matrix_[k * C + j] *= inv;
+      }
+      for (int i = 0; i < R; ++i) {
+        const T l = a.matrix_[i * C + k];
+        if ((i == k) || (l == 0)) {
+          continue;
+        }
+        for (int j = 0; j < C; ++j) {
+          a.matrix_[i * C + j] -= l * a.matrix_[k * C + j];
+          res.matrix_[i * C + j] -= l * res.matrix_[k * C + j];
+        }
+      }
+    }
+    return res;
+  }
+
+  constexpr int pivotRow(const int k) const noexcept {
+    int p = k;
+    for (int i = k + 1; i < R; ++i) {
+      if (abs(matrix_[i * C + k]) > abs(matrix_[p * C + k])) {
+        p = i;
+      }
+    }
+    return p;
+  }
+
+  constexpr void swapRows(const int a, const int b) noexcept {
+    for (int j = 0; j < C; ++j) {
+      const T tmp = matrix_[a * C + j];
+      matrix_[a * C + j] = matrix_[b * C + j];
+      matrix_[b * C + j] = tmp;
+    }
+  }
+};
+
+// T is deduced from the matrix alone, so 2 * m converts like m * 2.
+template <int R, int C, typename T>
+constexpr S21FixedMatrix<R, C, T> operator*(
+    const typename S21FixedMatrix<R, C, T>::value_type num,
+    const S21FixedMatrix<R, C, T>& other) noexcept {
+  return other * num;
+}
+
+using S21Matrix3 = S21FixedMatrix<3, 3>;
+using S21Matrix4 = S21FixedMatrix<4, 4>;
+
+#endif  // S21_MATRIX_FIXED_H_
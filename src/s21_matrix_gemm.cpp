@@ -0,0 +1,366 @@
+#include "s21_matrix_gemm.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+#include "s21_matrix_parallel.h"
+#include "s21_matrix_simd.h"
+
+namespace {
+
+// Register tile computed by the micro-kernel.
+constexpr int kMR = 4;
+constexpr int kNR = 8;
+
+// Cache blocks: an MC x KC panel of A stays in L2, a KC x NR sliver of B
+// in L1, and a KC x NC panel of B in L3.
+constexpr int kMC = 96;
+constexpr int kKC = 256;
+constexpr int kNC = 2048;
+
+// Products smaller than this many multiply-adds skip packing.
+constexpr long kSmallSize = 32 * 32 * 32;
+
+// Products smaller than this many multiply-adds run on one thread.
+constexpr long kParallelSize = 64 * 64 * 64;
+
+template <typename T>
+void gemmSmall(const int m, const int n, const int k, const T* a,
+               const int lda, const T* b, const int ldb, T* c, const int ldc) {
+  for (int i = 0; i < m; ++i) {
+    T* c_row = c + i * ldc;
+    for (int p = 0; p < k; ++p) {
+      const T a_ip = a[i * lda + p];
+      const T* b_row = b + p * ldb;
+      for (int j = 0; j < n; ++j) {
+        c_row[j] += a_ip * b_row[j];
+      }
+    }
+  }
+}
+
+// Packs an mc x kc block of A into kMR-row panels, column by column.
+// Rows past mc are zero-padded.
+template <typename T>
+void packA(const int mc, const int kc, const T* a, const int lda, T* buffer) {
+  for (int i = 0; i < mc; i += kMR) {
+    const int rows = std::min(kMR, mc - i);
+    for (int p = 0; p < kc; ++p) {
+      for (int r = 0; r < rows; ++r) {
+        buffer[r] = a[(i + r) * lda + p];
+      }
+      for (int r = rows; r < kMR; ++r) {
+        buffer[r] = 0;
+      }
+      buffer += kMR;
+    }
+  }
+}
+
+// Packs a kc x nc block of B into kNR-column panels, row by row.
+// Columns past nc are zero-padded.
+template <typename T>
+void packB(const int kc, const int nc, const T* b, const int ldb, T* buffer) {
+  for (int j = 0; j < nc; j += kNR) {
+    const int cols = std::min(kNR, nc - j);
+    for (int p = 0; p < kc; ++p) {
+      const T* b_row = b + p * ldb + j;
+      for (int r = 0; r < cols; ++r) {
+        buffer[r] = b_row[r];
+      }
+      for (int r = cols; r < kNR; ++r) {
+        buffer[r] = 0;
+      }
+      buffer += kNR;
+    }
+  }
+}
+
+// Multiplies a packed kMR x kc panel by a packed kc x kNR panel and adds
+// the top-left mr x nr part of the product to C.
+template <typename T>
+void microKernel(const int kc, const T* a, const T* b, T* c, const int ldc,
+                 const int mr, const int nr) {
+  T acc[kMR][kNR] = {};
+
+  for (int p = 0; p < kc; ++p) {
+    for (int r = 0; r < kMR; ++r) {
+      const T a_rp = a[r];
+      for (int s = 0; s < kNR; ++s) {
+        acc[r][s] += a_rp * b[s];
+      }
+    }
+    a += kMR;
+    b += kNR;
+  }
+
+  if ((mr == kMR) && (nr == kNR)) {
+    for (int r = 0; r < kMR; ++r) {
+      for (int s = 0; s < kNR; ++s) {
+        c[r * ldc + s] += acc[r][s];
+      }
+    }
+  } else {
+    for (int r = 0; r < mr; ++r) {
+      for (int s = 0; s < nr; ++s) {
+        c[r * ldc + s] += acc[r][s];
+      }
+    }
+  }
+}
+
+template <typename T>
+void gemmBlocked(const int m, const int n, const int k, const T* a,
+                 const int lda, const T* b, const int ldb, T* c,
+                 const int ldc) {
+  const int nc_max = std::min(kNC, (n + kNR - 1) / kNR * kNR);
+  const int mc_max = std::min(kMC, (m + kMR - 1) / kMR * kMR);
+  std::vector<T> packed_a(static_cast<std::size_t>(mc_max) * kKC);
+  std::vector<T> packed_b(static_cast<std::size_t>(nc_max) * kKC);
+
+  for (int jc = 0; jc < n; jc += kNC) {
+    const int nc = std::min(kNC, n - jc);
+    for (int pc = 0; pc < k; pc += kKC) {
+      const int kc = std::min(kKC, k - pc);
+      packB(kc, nc, b + pc * ldb + jc, ldb, packed_b.data());
+
+      for (int ic = 0; ic < m; ic += kMC) {
+        const int mc = std::min(kMC, m - ic);
+        packA(mc, kc, a + ic * lda + pc, lda, packed_a.data());
+
+        for (int jr = 0; jr < nc; jr += kNR) {
+          const int nr = std::min(kNR, nc - jr);
+          const T* b_panel = packed_b.data() + jr * kc;
+          for (int ir = 0; ir < mc; ir += kMR) {
+            const int mr = std::min(kMR, mc - ir);
+            microKernel(kc, packed_a.data() + ir * kc, b_panel,
+                        c + (ic + ir) * ldc + jc + jr, ldc, mr, nr);
+          }
+        }
+      }
+    }
+  }
+}
+
+template <typename T>
+void gemmClassical(const int m, const int n, const int k, const T* a,
+                   const int lda, const T* b, const int ldb, T* c,
+                   const int ldc) {
+  const long size = static_cast<long>(m) * n * k;
+
+  if (size < kSmallSize) {
+    gemmSmall(m, n, k, a, lda, b, ldb, c, ldc);
+    return;
+  }
+
+  S21Executor& executor = s21_get_executor();
+  const int threads = executor.Concurrency();
+
+  if ((size < kParallelSize) || (threads < 2)) {
+    gemmBlocked(m, n, k, a, lda, b, ldb, c, ldc);
+    return;
+  }
+
+  // Each task owns a band of rows (or columns for wide, short products) of C
+  // and packs its own panels, so tasks never share writable memory.
+  const bool by_rows = m >= n;
+  const int extent = by_rows ? m : n;
+  const int unit = by_rows ? kMR : kNR;
+  const int units = (extent + unit - 1) / unit;
+  const int tasks = std::min(threads, units);
+  const int band = (units + tasks - 1) / tasks * unit;
+  const int count = (extent + band - 1) / band;
+
+  executor.ParallelFor(count, [&](int index) {
+    const int begin = index * band;
+    const int length = std::min(band, extent - begin);
+    if (by_rows) {
+      gemmBlocked(length, n, k, a + begin * lda, lda, b, ldb,
+                  c + begin * ldc, ldc);
+    } else {
+      gemmBlocked(m, length, k, a, lda, b + begin, ldb, c + begin, ldc);
+    }
+  });
+}
+
+std::atomic<int> strassen_threshold{0};
+
+// Scratch needed by one Strassen level and everything below it.
+std::size_t strassenWorkspace(const int m, const int n, const int k,
+                              const int cutoff) {
+  if (std::min({m, n, k}) <= cutoff) {
+    return 0;
+  }
+  const std::size_t mh = m / 2, nh = n / 2, kh = k / 2;
+  return 2 * mh * nh + mh * kh + kh * nh +
+         strassenWorkspace(m / 2, n / 2, k / 2, cutoff);
+}
+
+void copyBlock(double* dst, const double* src, const int rows, const int cols,
+               const int ldd, const int lds) {
+  for (int i = 0; i < rows; ++i) {
+    std::memcpy(dst + i * ldd, src + i * lds, sizeof(double) * cols);
+  }
+}
+
+void zeroBlock(double* dst, const int rows, const int cols, const int ldd) {
+  for (int i = 0; i < rows; ++i) {
+    std::memset(dst + i * ldd, 0, sizeof(double) * cols);
+  }
+}
+
+void strassen(const int m, const int n, const int k, const double* a,
+              const int lda, const double* b, const int ldb, double* c,
+              const int ldc, const int cutoff, double* work) {
+  if (std::min({m, n, k}) <= cutoff) {
+    gemmClassical(m, n, k, a, lda, b, ldb, c, ldc);
+    return;
+  }
+
+  const int mh = m / 2, nh = n / 2, kh = k / 2;
+  const S21SimdKernels& kernels = s21_simd_kernels();
+
+  const double* a11 = a;
+  const double* a12 = a + kh;
+  const double* a21 = a + mh * lda;
+  const double* a22 = a21 + kh;
+  const double* b11 = b;
+  const double* b12 = b + nh;
+  const double* b21 = b + kh * ldb;
+  const double* b22 = b21 + nh;
+  double* c11 = c;
+  double* c12 = c + nh;
+  double* c21 = c + mh * ldc;
+  double* c22 = c21 + nh;
+
+  // Level scratch: W and Q are mh x nh, S is mh x kh, T is kh x nh.
+  double* w = work;
+  double* q = w + mh * nh;
+  double* s = q + mh * nh;
+  double* t = s + mh * kh;
+  double* next = t + kh * nh;
+
+  // C11 += P1 + P2, W = P1.
+  zeroBlock(w, mh, nh, nh);
+  strassen(mh, nh, kh, a11, lda, b11, ldb, w, nh, cutoff, next);
+  kernels.add(c11, w, mh, nh, ldc, nh);
+  strassen(mh, nh, kh, a12, lda, b21, ldb, c11, ldc, cutoff, next);
+
+  // W = U = P1 + P6, with S2 = A21 + A22 - A11, T2 = B22 - B12 + B11.
+  copyBlock(s, a21, mh, kh, kh, lda);
+  kernels.add(s, a22, mh, kh, kh, lda);
+  kernels.sub(s, a11, mh, kh, kh, lda);
+  copyBlock(t, b22, kh, nh, nh, ldb);
+  kernels.sub(t, b12, kh, nh, nh, ldb);
+  kernels.add(t, b11, kh, nh, nh, ldb);
+  strassen(mh, nh, kh, s, kh, t, nh, w, nh, cutoff, next);
+  kernels.add(c12, w, mh, nh, ldc, nh);
+  kernels.add(c21, w, mh, nh, ldc, nh);
+  kernels.add(c22, w, mh, nh, ldc, nh);
+
+  // P5 = S1 * T1 goes to C12 and C22, with S1 = A21 + A22, T1 = B12 - B11.
+  copyBlock(s, a21, mh, kh, kh, lda);
+  kernels.add(s, a22, mh, kh, kh, lda);
+  copyBlock(t, b12, kh, nh, nh, ldb);
+  kernels.sub(t, b11, kh, nh, nh, ldb);
+  zeroBlock(q, mh, nh, nh);
+  strassen(mh, nh, kh, s, kh, t, nh, q, nh, cutoff, next);
+  kernels.add(c12, q, mh, nh, ldc, nh);
+  kernels.add(c22, q, mh, nh, ldc, nh);
+
+  // P7 = S3 * T3 goes to C21 and C22, with S3 = A11 - A21, T3 = B22 - B12.
+  copyBlock(s, a11, mh, kh, kh, lda);
+  kernels.sub(s, a21, mh, kh, kh, lda);
+  copyBlock(t, b22, kh, nh, nh, ldb);
+  kernels.sub(t, b12, kh, nh, nh, ldb);
+  zeroBlock(q, mh, nh, nh);
+  strassen(mh, nh, kh, s, kh, t, nh, q, nh, cutoff, next);
+  kernels.add(c21, q, mh, nh, ldc, nh);
+  kernels.add(c22, q, mh, nh, ldc, nh);
+
+  // C12 += P3 = S4 * B22, with S4 = A12 - S2 = A12 - A21 - A22 + A11.
+  copyBlock(s, a12, mh, kh, kh, lda);
+  kernels.sub(s, a21, mh, kh, kh, lda);
+  kernels.sub(s, a22, mh, kh, kh, lda);
+  kernels.add(s, a11, mh, kh, kh, lda);
+  strassen(mh, nh, kh, s, kh, b22, ldb, c12, ldc, cutoff, next);
+
+  // C21 -= P4 = A22 * T4, as C21 += A22 * (-T4) with
+  // -T4 = B21 - T2 = B21 - B22 + B12 - B11.
+  copyBlock(t, b21, kh, nh, nh, ldb);
+  kernels.sub(t, b22, kh, nh, nh, ldb);
+  kernels.add(t, b12, kh, nh, nh, ldb);
+  kernels.sub(t, b11, kh, nh, nh, ldb);
+  strassen(mh, nh, kh, a22, lda, t, nh, c21, ldc, cutoff, next);
+
+  // Peel odd dimensions: the last inner index, row and column of C.
+  const int me = 2 * mh, ne = 2 * nh, ke = 2 * kh;
+  if (ke < k) {
+    gemmClassical(me, ne, k - ke, a + ke, lda, b + ke * ldb, ldb, c, ldc);
+  }
+  if (me < m) {
+    gemmClassical(m - me, n, k, a + me * lda, lda, b, ldb, c + me * ldc,
+                  ldc);
+  }
+  if (ne < n) {
+    gemmClassical(me, n - ne, k, a, lda, b + ne, ldb, c + ne, ldc);
+  }
+}
+
+}  // namespace
+
+void s21_gemm(const int m, const int n, const int k, const float* a,
+              const int lda, const float* b, const int ldb, float* c,
+              const int ldc) {
+  if ((m <= 0) || (n <= 0) || (k <= 0)) {
+    return;
+  }
+
+  gemmClassical(m, n, k, a, lda, b, ldb, c, ldc);
+}
+
+void s21_gemm(const int m, const int n, const int k, const long double* a,
+              const int lda, const long double* b, const int ldb,
+              long double* c, const int ldc) {
+  if ((m <= 0) || (n <= 0) || (k <= 0)) {
+    return;
+  }
+
+  gemmClassical(m, n, k, a, lda, b, ldb, c, ldc);
+}
+
+void s21_gemm(const int m, const int n, const int k, const double* a,
+              const int lda, const double* b, const int ldb, double* c,
+              const int ldc) {
+  if ((m <= 0) || (n <= 0) || (k <= 0)) {
+    return;
+  }
+
+  const int threshold = strassen_threshold.load();
+  if ((threshold > 0) && (std::min({m, n, k}) >= threshold)) {
+    s21_gemm_strassen(m, n, k, a, lda, b, ldb, c, ldc);
+    return;
+  }
+
+  gemmClassical(m, n, k, a, lda, b, ldb, c, ldc);
+}
+
+void s21_gemm_strassen(const int m, const int n, const int k, const double* a,
+                       const int lda, const double* b, const int ldb,
+                       double* c, const int ldc, const int cutoff) {
+  if ((m <= 0) || (n <= 0) || (k <= 0)) {
+    return;
+  }
+
+  const int leaf = std::max(cutoff, 1);
+  std::vector<double> work(strassenWorkspace(m, n, k, leaf));
+  strassen(m, n, k, a, lda, b, ldb, c, ldc, leaf, work.data());
+}
+
+void s21_set_strassen_threshold(const int size) noexcept {
+  strassen_threshold.store(size > 0 ? size : 0);
+}
+
+int s21_get_strassen_threshold() noexcept { return strassen_threshold.load(); }
@@ -0,0 +1,42 @@
+#ifndef S21_MATRIX_GEMM_H_
+#define S21_MATRIX_GEMM_H_
+
+// Sub-products at or below this size in any dimension leave the
+// Strassen-Winograd recursion and use the classical kernel.
+#define S21_STRASSEN_CUTOFF 256
+
+// C += A * B for row-major m x k matrix A and k x n matrix B.
+// lda, ldb and ldc are the row strides of A, B and C in elements.
+// Uses s21_gemm_strassen() when m, n and k all reach the Strassen threshold.
+void s21_gemm(const int m, const int n, const int k, const double* a,
+              const int lda, const double* b, const int ldb, double* c,
+              const int ldc);
+
+// The same product for float and long double. These always take the
+// classical path; Strassen-Winograd is only provided for double.
+void s21_gemm(const int m, const int n, const int k, const float* a,
+              const int lda, const float* b, const int ldb, float* c,
+              const int ldc);
+void s21_gemm(const int m, const int n, const int k, const long double* a,
+              const int lda, const long double* b, const int ldb,
+              long double* c, const int ldc);
+
+// C += A * B by Strassen-Winograd recursion: 7 half-size products and 15
+// additions per level, odd dimensions handled by peeling the last
+// row/column. Scratch space for all levels is allocated once.
+//
+// Accuracy: with l levels of recursion above a leaf size n0, the
+// normwise error grows like 18^l * (n0^2 + 5 * n0) * u * |A| * |B|
+// (u = 2^-53) instead of the classical n * u * |A| * |B|. One level
+// therefore costs about four extra bits of precision.
+void s21_gemm_strassen(const int m, const int n, const int k, const double* a,
+                       const int lda, const double* b, const int ldb,
+                       double* c, const int ldc,
+                       const int cutoff = S21_STRASSEN_CUTOFF);
+
+// Minimum m, n and k for s21_gemm() to pick Strassen-Winograd; 0 (the
+// default) keeps every product classical.
+void s21_set_strassen_threshold(const int size) noexcept;
+int s21_get_strassen_threshold() noexcept;
+
+#endif  // S21_MATRIX_GEMM_H_
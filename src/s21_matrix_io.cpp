@@ -0,0 +1,346 @@
+#include "s21_matrix_io.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace {
+
+constexpr char kMagic[8] = {'S', '2', '1', 'M', 'T', 'X', '\0', '\0'};
+constexpr std::uint64_t kFnvPrime = 1099511628211ULL;
+
+constexpr std::uint8_t nativeEndian() noexcept {
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+  return S21MatrixFileHeader::kBigEndian;
+#else
+  return S21MatrixFileHeader::kLittleEndian;
+#endif
+}
+
+template <typename T>
+void byteSwap(T& value) noexcept {
+  unsigned char bytes[sizeof(T)];
+  std::memcpy(bytes, &value, sizeof(T));
+  for (std::size_t i = 0; i < sizeof(T) / 2; ++i) {
+    const unsigned char tmp = bytes[i];
+    bytes[i] = bytes[sizeof(T) - 1 - i];
+    bytes[sizeof(T) - 1 - i] = tmp;
+  }
+  std::memcpy(&value, bytes, sizeof(T));
+}
+
+void byteSwapHeader(S21MatrixFileHeader& header) noexcept {
+  byteSwap(header.version);
+  byteSwap(header.header_size);
+  byteSwap(header.reserved);
+  byteSwap(header.rows);
+  byteSwap(header.cols);
+  byteSwap(header.stride);
+  byteSwap(header.payload_bytes);
+  byteSwap(header.checksum);
+}
+
+// File element type of T; only float and double have one.
+template <typename T>
+struct FileType;
+
+template <>
+struct FileType<float> {
+  static constexpr std::uint8_t kValue = S21MatrixFileHeader::kFloat32;
+};
+
+template <>
+struct FileType<double> {
+  static constexpr std::uint8_t kValue = S21MatrixFileHeader::kFloat64;
+};
+
+std::size_t elementSize(const std::uint8_t dtype) noexcept {
+  return dtype == S21MatrixFileHeader::kFloat32 ? sizeof(float)
+                                                : sizeof(double);
+}
+
+// Validates a header already converted to native byte order against the
+// expected element type.
+void checkHeader(const S21MatrixFileHeader& header, const char* func,
+                 const std::uint8_t dtype = S21MatrixFileHeader::kFloat64) {
+  const std::string prefix = std::string(func) + ": ";
+
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+    throw std::runtime_error(prefix + "not a matrix file");
+  }
+
+  if ((header.version < 1) ||
+      (header.version > S21MatrixFileHeader::kVersion)) {
+    throw std::runtime_error(prefix + "unsupported format version");
+  }
+
+  if (header.dtype != dtype) {
+    throw std::runtime_error(prefix + "unsupported element type");
+  }
+
+  if ((header.header_size < sizeof(S21MatrixFileHeader)) ||
+      (header.header_size % S21Allocator::kAlignment != 0)) {
+    throw std::runtime_error(prefix + "invalid header size");
+  }
+
+  if ((header.rows < 1) || (header.cols < 1) ||
+      (header.stride < header.cols)) {
+    throw std::runtime_error(prefix + "invalid dimensions");
+  }
+
+  if (header.payload_bytes != elementSize(dtype) *
+                                  static_cast<std::uint64_t>(header.rows) *
+                                  static_cast<std::uint64_t>(header.stride)) {
+    throw std::runtime_error(prefix + "invalid payload size");
+  }
+}
+
+}  // namespace
+
+S21MatrixFileHeader S21MatrixFileHeader::Make(
+    const int rows, const int cols, const int stride,
+    const std::uint64_t checksum, const std::uint8_t dtype) noexcept {
+  S21MatrixFileHeader header = {};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.header_size = sizeof(S21MatrixFileHeader);
+  header.dtype = dtype;
+  header.endian = nativeEndian();
+  header.rows = rows;
+  header.cols = cols;
+  header.stride = stride;
+  header.payload_bytes =
+      elementSize(dtype) * static_cast<std::uint64_t>(rows) * stride;
+  header.checksum = checksum;
+  return header;
+}
+
+std::uint64_t s21_checksum(const void* data, std::size_t bytes,
+                           std::uint64_t hash) noexcept {
+  const unsigned char* bytes_ptr = static_cast<const unsigned char*>(data);
+  std::size_t i = 0;
+  for (; i + sizeof(std::uint64_t) <= bytes; i += sizeof(std::uint64_t)) {
+    std::uint64_t word;
+    std::memcpy(&word, bytes_ptr + i, sizeof(word));
+    if (nativeEndian() == S21MatrixFileHeader::kBigEndian) {
+      byteSwap(word);
+    }
+    hash = (hash ^ word) * kFnvPrime;
+  }
+  for (; i < bytes; ++i) {
+    hash = (hash ^ bytes_ptr[i]) * kFnvPrime;
+  }
+  return hash;
+}
+
+// S21BasicMatrix serialization
+
+template <typename T>
+void S21BasicMatrix<T>::Save(const std::string& path) const {
+  const std::size_t bytes =
+      sizeof(T) * static_cast<std::size_t>(rows_) * stride_;
+
+  const S21MatrixFileHeader header = S21MatrixFileHeader::Make(
+      rows_, cols_, stride_, s21_checksum(matrix_, bytes), FileType<T>::kValue);
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!file) {
+    throw std::runtime_error("Save: cannot open " + path);
+  }
+
+  file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  file.write(reinterpret_cast<const char*>(matrix_),
+             static_cast<std::streamsize>(bytes));
+
+  if (!file.flush()) {
+    throw std::runtime_error("Save: cannot write " + path);
+  }
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Load(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    throw std::runtime_error("Load: cannot open " + path);
+  }
+
+  S21MatrixFileHeader header;
+  if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+    throw std::runtime_error("Load: truncated file");
+  }
+
+  const bool swap = header.endian != nativeEndian();
+  if (swap) {
+    if ((header.endian != S21MatrixFileHeader::kLittleEndian) &&
+        (header.endian != S21MatrixFileHeader::kBigEndian)) {
+      throw std::runtime_error("Load: invalid byte order");
+    }
+    byteSwapHeader(header);
+  }
+  checkHeader(header, "Load", FileType<T>::kValue);
+  file.seekg(header.header_size);
+
+  S21BasicMatrix res(header.rows, header.cols);
+  const std::size_t row_bytes = sizeof(T) * header.stride;
+  std::vector<T> row(header.stride);
+  std::uint64_t hash = S21MatrixFileHeader::kChecksumSeed;
+
+  // Rows are read one at a time so files written with another stride load
+  // too; the checksum is over the payload bytes as stored, before swapping.
+  for (int i = 0; i < res.rows_; ++i) {
+    if (!file.read(reinterpret_cast<char*>(row.data()), row_bytes)) {
+      throw std::runtime_error("Load: truncated file");
+    }
+    hash = s21_checksum(row.data(), row_bytes, hash);
+    if (swap) {
+      for (T& value : row) {
+        byteSwap(value);
+      }
+    }
+    std::memcpy(res.matrix_ + i * res.stride_, row.data(),
+                sizeof(T) * res.cols_);
+  }
+
+  if (hash != header.checksum) {
+    throw std::runtime_error("Load: checksum mismatch");
+  }
+
+  return res;
+}
+
+template void S21BasicMatrix<float>::Save(const std::string& path) const;
+template void S21BasicMatrix<double>::Save(const std::string& path) const;
+template S21BasicMatrix<float> S21BasicMatrix<float>::Load(
+    const std::string& path);
+template S21BasicMatrix<double> S21BasicMatrix<double>::Load(
+    const std::string& path);
+
+// S21MappedMatrix
+
+S21MappedMatrix::S21MappedMatrix() noexcept
+    : base_(nullptr),
+      length_(0),
+      data_(nullptr),
+      rows_(0),
+      cols_(0),
+      stride_(0) {}
+
+S21MappedMatrix S21MappedMatrix::MapFile(const std::string& path,
+                                         const bool verify) {
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("MapFile: cannot open " + path);
+  }
+
+  struct stat info;
+  if ((fstat(fd, &info) != 0) ||
+      (static_cast<std::size_t>(info.st_size) < sizeof(S21MatrixFileHeader))) {
+    close(fd);
+    throw std::runtime_error("MapFile: truncated file");
+  }
+
+  S21MappedMatrix res;
+  res.length_ = static_cast<std::size_t>(info.st_size);
+  void* base = mmap(nullptr, res.length_, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED) {
+    throw std::runtime_error("MapFile: cannot map " + path);
+  }
+  res.base_ = base;
+
+  S21MatrixFileHeader header;
+  std::memcpy(&header, base, sizeof(header));
+  if (header.endian != nativeEndian()) {
+    throw std::runtime_error("MapFile: file uses a different byte order");
+  }
+  checkHeader(header, "MapFile");
+
+  if ((header.header_size > res.length_) ||
+      (res.length_ - header.header_size < header.payload_bytes)) {
+    throw std::runtime_error("MapFile: truncated file");
+  }
+
+  res.data_ = reinterpret_cast<const double*>(static_cast<const char*>(base) +
+                                              header.header_size);
+  res.rows_ = header.rows;
+  res.cols_ = header.cols;
+  res.stride_ = header.stride;
+
+  if (verify && (s21_checksum(res.data_, header.payload_bytes) !=
+                 header.checksum)) {
+    throw std::runtime_error("MapFile: checksum mismatch");
+  }
+
+  return res;
+}
+
+S21MappedMatrix::S21MappedMatrix(S21MappedMatrix&& other) noexcept
+    : base_(other.base_),
+      length_(other.length_),
+      data_(other.data_),
+      rows_(other.rows_),
+      cols_(other.cols_),
+      stride_(other.stride_) {
+  other.base_ = nullptr;
+  other.length_ = 0;
+  other.data_ = nullptr;
+}
+
+S21MappedMatrix& S21MappedMatrix::operator=(S21MappedMatrix&& other) noexcept {
+  if (this == &other) {
+    return *this;
+  }
+
+  unmap();
+
+  base_ = other.base_;
+  length_ = other.length_;
+  data_ = other.data_;
+  rows_ = other.rows_;
+  cols_ = other.cols_;
+  stride_ = other.stride_;
+
+  other.base_ = nullptr;
+  other.length_ = 0;
+  other.data_ = nullptr;
+
+  return *this;
+}
+
+S21MappedMatrix::~S21MappedMatrix() { unmap(); }
+
+void S21MappedMatrix::unmap() noexcept {
+  if (base_) {
+    munmap(base_, length_);
+    base_ = nullptr;
+  }
+}
+
+int S21MappedMatrix::getRows() const noexcept { return rows_; }
+
+int S21MappedMatrix::getCols() const noexcept { return cols_; }
+
+int S21MappedMatrix::getStride() const noexcept { return stride_; }
+
+const double* S21MappedMatrix::getData() const noexcept { return data_; }
+
+S21MatrixView S21MappedMatrix::View() const noexcept {
+  return S21MatrixView(data_, rows_, cols_, stride_, -1, -1, false);
+}
+
+double S21MappedMatrix::operator()(const int i, const int j) const {
+  if ((i < 0) || (i > rows_ - 1)) {
+    throw std::out_of_range("i argument out of range");
+  }
+
+  if ((j < 0) || (j > cols_ - 1)) {
+    throw std::out_of_range("j argument out of range");
+  }
+
+  return data_[i * stride_ + j];
+}
@@ -0,0 +1,106 @@
+#ifndef S21_MATRIX_IO_H_
+#define S21_MATRIX_IO_H_
+
+#include <cstdint>
+#include <string>
+
+#include "s21_matrix_oop.h"
+
+// Binary matrix file, written by S21BasicMatrix::Save:
+//
+//   offset  size  field
+//        0     8  magic "S21MTX\0\0"
+//        8     4  format version
+//       12     4  header size, the payload offset
+//       16     1  element type, 1 = IEEE 754 double, 2 = IEEE 754 float
+//       17     1  byte order, 1 = little endian, 2 = big endian
+//       18     2  reserved, zero
+//       20     4  rows
+//       24     4  cols
+//       28     4  row stride in elements
+//       32     8  payload size in bytes
+//       40     8  payload checksum
+//       48    16  reserved, zero
+//
+// All header fields use the byte order recorded in the file. The payload is
+// rows * stride elements, rows padded exactly as in memory, and starts on a
+// kAlignment boundary so it can be used in place once mapped.
+struct S21MatrixFileHeader {
+  static constexpr std::uint32_t kVersion = 1;
+  static constexpr std::uint8_t kFloat64 = 1;
+  static constexpr std::uint8_t kFloat32 = 2;
+  static constexpr std::uint8_t kLittleEndian = 1;
+  static constexpr std::uint8_t kBigEndian = 2;
+  static constexpr std::uint64_t kChecksumSeed = 14695981039346656037ULL;
+
+  // Header of a native byte order matrix, double unless dtype says
+  // otherwise.
+  static S21MatrixFileHeader Make(const int rows, const int cols,
+                                  const int stride,
+                                  const std::uint64_t checksum,
+                                  const std::uint8_t dtype = kFloat64) noexcept;
+
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t header_size;
+  std::uint8_t dtype;
+  std::uint8_t endian;
+  std::uint16_t reserved;
+  std::int32_t rows;
+  std::int32_t cols;
+  std::int32_t stride;
+  std::uint64_t payload_bytes;
+  std::uint64_t checksum;
+  std::uint8_t padding[16];
+};
+
+static_assert(sizeof(S21MatrixFileHeader) == S21Allocator::kAlignment,
+              "header must keep the payload aligned");
+
+// 64-bit checksum of a payload, FNV-1a over 8-byte words read as little
+// endian, so the same bytes hash the same on every machine. A file holds
+// the checksum of its payload bytes as stored, whatever the element type
+// or byte order. A payload can be hashed in pieces by passing the previous
+// result as hash; every piece but the last must be a whole number of words.
+std::uint64_t s21_checksum(
+    const void* data, std::size_t bytes,
+    std::uint64_t hash = S21MatrixFileHeader::kChecksumSeed) noexcept;
+
+// Read-only double matrix backed by a shared memory mapping of a file
+// written by S21Matrix::Save. Pages are loaded on first touch and shared
+// with every other process mapping the same file. Move-only; the mapping is
+// released by the destructor, which invalidates views taken from it.
+class S21MappedMatrix {
+ public:
+  // Maps path. The file must use this machine's byte order. The checksum
+  // reads the whole payload, so it is only verified on request.
+  static S21MappedMatrix MapFile(const std::string& path,
+                                 const bool verify = false);
+
+  S21MappedMatrix(S21MappedMatrix&& other) noexcept;
+  S21MappedMatrix& operator=(S21MappedMatrix&& other) noexcept;
+  S21MappedMatrix(const S21MappedMatrix&) = delete;
+  S21MappedMatrix& operator=(const S21MappedMatrix&) = delete;
+  ~S21MappedMatrix();
+
+  // Accessors
+  int getRows() const noexcept;
+  int getCols() const noexcept;
+  int getStride() const noexcept;
+  const double* getData() const noexcept;
+
+  // Functions
+  S21MatrixView View() const noexcept;
+  double operator()(const int i, const int j) const;
+
+ private:
+  void* base_;
+  std::size_t length_;
+  const double* data_;
+  int rows_, cols_, stride_;
+
+  S21MappedMatrix() noexcept;
+  void unmap() noexcept;
+};
+
+#endif  // S21_MATRIX_IO_H_
@@ -0,0 +1,153 @@
+#ifndef S21_MATRIX_ITERATOR_H_
+#define S21_MATRIX_ITERATOR_H_
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+// Random access iterator over the elements of a padded row-major buffer in
+// row-major order, skipping the padding at the end of each row. T is float,
+// double or long double, possibly const. Advancing by one is a pointer
+// increment plus a row-end check; jumps and differences divide by the row
+// length.
+template <typename T>
+class S21MatrixIterator {
+ public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = std::remove_const_t<T>;
+  using difference_type = std::ptrdiff_t;
+  using pointer = T*;
+  using reference = T&;
+
+  S21MatrixIterator() noexcept = default;
+  S21MatrixIterator(T* row, const int col, const int cols,
+                    const int stride) noexcept
+      : row_(row), col_(col), cols_(cols), stride_(stride) {}
+
+  // iterator converts to const_iterator.
+  template <typename U,
+            typename = std::enable_if_t<std::is_same<const U, T>::value &&
+                                        !std::is_same<U, T>::value>>
+  S21MatrixIterator(const S21MatrixIterator<U>& other) noexcept
+      : row_(other.row_),
+        col_(other.col_),
+        cols_(other.cols_),
+        stride_(other.stride_) {}
+
+  reference operator*() const noexcept { return row_[col_]; }
+  pointer operator->() const noexcept { return row_ + col_; }
+  reference operator[](const difference_type n) const noexcept {
+    return *(*this + n);
+  }
+
+  S21MatrixIterator& operator++() noexcept {
+    if (++col_ == cols_) {
+      col_ = 0;
+      row_ += stride_;
+    }
+    return *this;
+  }
+
+  S21MatrixIterator operator++(int) noexcept {
+    S21MatrixIterator res(*this);
+    ++*this;
+    return res;
+  }
+
+  S21MatrixIterator& operator--() noexcept {
+    if (col_ == 0) {
+      col_ = cols_;
+      row_ -= stride_;
+    }
+    --col_;
+    return *this;
+  }
+
+  S21MatrixIterator operator--(int) noexcept {
+    S21MatrixIterator res(*this);
+    --*this;
+    return res;
+  }
+
+  S21MatrixIterator& operator+=(const difference_type n) noexcept {
+    difference_type col = col_ + n;
+    difference_type rows = col / cols_;
+    col %= cols_;
+    if (col < 0) {
+      col += cols_;
+      --rows;
+    }
+    row_ += rows * stride_;
+    col_ = static_cast<int>(col);
+    return *this;
+  }
+
+  S21MatrixIterator& operator-=(const difference_type n) noexcept {
+    return *this += -n;
+  }
+
+  friend S21MatrixIterator operator+(S21MatrixIterator it,
+                                     const difference_type n) noexcept {
+    return it += n;
+  }
+
+  friend S21MatrixIterator operator+(const difference_type n,
+                                     S21MatrixIterator it) noexcept {
+    return it += n;
+  }
+
+  friend S21MatrixIterator operator-(S21MatrixIterator it,
+                                     const difference_type n) noexcept {
+    return it -= n;
+  }
+
+  friend difference_type operator-(const S21MatrixIterator& a,
+                                   const S21MatrixIterator& b) noexcept {
+    const difference_type rows =
+        a.row_ == b.row_ ? 0 : (a.row_ - b.row_) / a.stride_;
+    return rows * a.cols_ + (a.col_ - b.col_);
+  }
+
+  friend bool operator==(const S21MatrixIterator& a,
+                         const S21MatrixIterator& b) noexcept {
+    return (a.row_ == b.row_) && (a.col_ == b.col_);
+  }
+
+  friend bool operator!=(const S21MatrixIterator& a,
+                         const S21MatrixIterator& b) noexcept {
+    return !(a == b);
+  }
+
+  friend bool operator<(const S21MatrixIterator& a,
+                        const S21MatrixIterator& b) noexcept {
+    return (a.row_ < b.row_) || ((a.row_ == b.row_) && (a.col_ < b.col_));
+  }
+
+  friend bool operator>(const S21MatrixIterator& a,
+                        const S21MatrixIterator& b) noexcept {
+    return b < a;
+  }
+
+  friend bool operator<=(const S21MatrixIterator& a,
+                         const S21MatrixIterator& b) noexcept {
+    return !(b < a);
+  }
+
+  friend bool operator>=(const S21MatrixIterator& a,
+                         const S21MatrixIterator& b) noexcept {
+    return !(a < b);
+  }
+
+ private:
+  template <typename U>
+  friend class S21MatrixIterator;
+
+  // Start of the current row and the column within it; end() is the start
+  // of the row past the last one.
+  T* row_ = nullptr;
+  int col_ = 0;
+  int cols_ = 1;
+  int stride_ = 1;
+};
+
+#endif  // S21_MATRIX_ITERATOR_H_
@@ -0,0 +1,245 @@
+#include "s21_matrix_lu.h"
+
+#include <algorithm>
+
+template <typename T>
+S21BasicLU<T>::S21BasicLU(const S21BasicMatrix<T>& matrix)
+    : lu_(matrix), pivots_(), scales_(), sign_(1), singular_(false) {
+  if (matrix.rows_ != matrix.cols_) {
+    throw std::domain_error("S21LU: matrix must be squared");
+  }
+
+  const int n = lu_.rows_;
+  const int stride = lu_.stride_;
+  T* a = lu_.matrix_;
+
+  pivots_.resize(n);
+  scales_.assign(n, 0);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      scales_[j] = std::max(scales_[j], std::abs(a[i * stride + j]));
+    }
+  }
+
+  for (int k = 0; k < n; ++k) {
+    int p = k;
+    T max = std::abs(a[k * stride + k]);
+    for (int i = k + 1; i < n; ++i) {
+      T value = std::abs(a[i * stride + k]);
+      if (value > max) {
+        max = value;
+        p = i;
+      }
+    }
+
+    pivots_[k] = p;
+    if (p != k) {
+      std::swap_ranges(a + k * stride, a + k * stride + n, a + p * stride);
+      sign_ = -sign_;
+    }
+
+    if (negligible(k)) {
+      singular_ = true;
+    }
+
+    if (max == 0) {
+      continue;
+    }
+
+    const T pivot = a[k * stride + k];
+    const T* row_k = a + k * stride;
+    for (int i = k + 1; i < n; ++i) {
+      T* row_i = a + i * stride;
+      const T l = row_i[k] / pivot;
+      row_i[k] = l;
+      for (int j = k + 1; j < n; ++j) {
+        row_i[j] -= l * row_k[j];
+      }
+    }
+  }
+}
+
+template <typename T>
+bool S21BasicLU<T>::negligible(const int k) const noexcept {
+  return std::abs(lu_.matrix_[k * lu_.stride_ + k]) <=
+         S21Tolerance<T>::kEps * scales_[k];
+}
+
+template <typename T>
+int S21BasicLU<T>::getSize() const noexcept { return lu_.rows_; }
+
+template <typename T>
+const S21BasicMatrix<T>& S21BasicLU<T>::getLU() const noexcept { return lu_; }
+
+template <typename T>
+const std::vector<int>& S21BasicLU<T>::getPivots() const noexcept {
+  return pivots_;
+}
+
+template <typename T>
+bool S21BasicLU<T>::IsSingular() const noexcept { return singular_; }
+
+template <typename T>
+T S21BasicLU<T>::Determinant() const noexcept {
+  T det = sign_;
+
+  for (int i = 0; i < lu_.rows_; ++i) {
+    det *= lu_.matrix_[i * lu_.stride_ + i];
+  }
+
+  return det;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicLU<T>::Inverse() const {
+  if (singular_) {
+    throw std::domain_error("S21LU: matrix is singular");
+  }
+
+  const int n = lu_.rows_;
+  S21BasicMatrix<T> x(n, n);
+
+  for (int i = 0; i < n; ++i) {
+    x.matrix_[i * x.stride_ + i] = 1;
+  }
+
+  substitute(x);
+
+  return x;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicLU<T>::Solve(const S21BasicMatrix<T>& b) const {
+  S21BasicMatrix<T> x(b);
+  SolveInPlace(x);
+  return x;
+}
+
+template <typename T>
+void S21BasicLU<T>::SolveInPlace(S21BasicMatrix<T>& b) const {
+  if (b.rows_ != lu_.rows_) {
+    throw std::invalid_argument("S21LU: different dimensions");
+  }
+
+  if (singular_) {
+    throw std::domain_error("S21LU: matrix is singular");
+  }
+
+  substitute(b);
+}
+
+// For a matrix of rank n - 1 finds x and y with A * x = 0 and y^T * A = 0.
+// Returns false when the matrix is nonsingular or its rank is below n - 1.
+template <typename T>
+bool S21BasicLU<T>::NullVectors(std::vector<T>& right,
+                                std::vector<T>& left) const {
+  const int n = lu_.rows_;
+  const int stride = lu_.stride_;
+  const T* a = lu_.matrix_;
+
+  int k = -1;
+  for (int i = 0; i < n; ++i) {
+    if (negligible(i)) {
+      if (k != -1) {
+        return false;
+      }
+      k = i;
+    }
+  }
+
+  if (k == -1) {
+    return false;
+  }
+
+  // U * x = 0 with x[k] = 1 and x[j] = 0 for j > k.
+  right.assign(n, 0);
+  right[k] = 1;
+  for (int i = k - 1; i >= 0; --i) {
+    T sum = a[i * stride + k];
+    for (int j = i + 1; j < k; ++j) {
+      sum += a[i * stride + j] * right[j];
+    }
+    right[i] = -sum / a[i * stride + i];
+  }
+
+  // z^T * U = 0 with z[k] = 1 and z[j] = 0 for j < k.
+  left.assign(n, 0);
+  left[k] = 1;
+  for (int j = k + 1; j < n; ++j) {
+    T sum = 0;
+    for (int i = k; i < j; ++i) {
+      sum += left[i] * a[i * stride + j];
+    }
+    left[j] = -sum / a[j * stride + j];
+  }
+
+  // L^T * w = z, then undo the row interchanges: y = P^T * w.
+  for (int i = n - 1; i >= 0; --i) {
+    T sum = left[i];
+    for (int j = i + 1; j < n; ++j) {
+      sum -= a[j * stride + i] * left[j];
+    }
+    left[i] = sum;
+  }
+
+  for (int i = n - 1; i >= 0; --i) {
+    std::swap(left[i], left[pivots_[i]]);
+  }
+
+  return true;
+}
+
+// Overwrites x with A^-1 * x. Works on whole rows of x so every update is
+// a contiguous axpy over the right-hand sides.
+template <typename T>
+void S21BasicLU<T>::substitute(S21BasicMatrix<T>& x) const noexcept {
+  const int n = lu_.rows_;
+  const int m = x.cols_;
+  const int stride = lu_.stride_;
+  const int x_stride = x.stride_;
+  const T* a = lu_.matrix_;
+  T* b = x.matrix_;
+
+  for (int k = 0; k < n; ++k) {
+    if (pivots_[k] != k) {
+      std::swap_ranges(b + k * x_stride, b + k * x_stride + m,
+                       b + pivots_[k] * x_stride);
+    }
+  }
+
+  for (int i = 1; i < n; ++i) {
+    T* row_i = b + i * x_stride;
+    for (int k = 0; k < i; ++k) {
+      const T l = a[i * stride + k];
+      if (l == 0) {
+        continue;
+      }
+      const T* row_k = b + k * x_stride;
+      for (int j = 0; j < m; ++j) {
+        row_i[j] -= l * row_k[j];
+      }
+    }
+  }
+
+  for (int i = n - 1; i >= 0; --i) {
+    T* row_i = b + i * x_stride;
+    for (int k = i + 1; k < n; ++k) {
+      const T u = a[i * stride + k];
+      if (u == 0) {
+        continue;
+      }
+      const T* row_k = b + k * x_stride;
+      for (int j = 0; j < m; ++j) {
+        row_i[j] -= u * row_k[j];
+      }
+    }
+    const T inv = 1 / a[i * stride + i];
+    for (int j = 0; j < m; ++j) {
+      row_i[j] *= inv;
+    }
+  }
+}
+
+template class S21BasicLU<float>;
+template class S21BasicLU<double>;
+template class S21BasicLU<long double>;
@@ -0,0 +1,50 @@
+#ifndef S21_MATRIX_LU_H_
+#define S21_MATRIX_LU_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// LU factorization with partial pivoting: P * A = L * U.
+// L (unit diagonal, not stored) and U are packed into one square matrix.
+// A pivot counts as zero when it is below kEps times the largest element of
+// its column in A, so scaling a column never changes IsSingular.
+template <typename T>
+class S21BasicLU {
+ public:
+  explicit S21BasicLU(const S21BasicMatrix<T>& matrix);
+
+  // Accessors
+  int getSize() const noexcept;
+  const S21BasicMatrix<T>& getLU() const noexcept;
+  const std::vector<int>& getPivots() const noexcept;
+
+  // Functions
+  bool IsSingular() const noexcept;
+  T Determinant() const noexcept;
+  S21BasicMatrix<T> Inverse() const;
+  bool NullVectors(std::vector<T>& right, std::vector<T>& left) const;
+
+  // A * X = B for every column of B, O(n^2) per column. SolveInPlace
+  // overwrites B with X and allocates nothing.
+  S21BasicMatrix<T> Solve(const S21BasicMatrix<T>& b) const;
+  void SolveInPlace(S21BasicMatrix<T>& b) const;
+
+ private:
+  S21BasicMatrix<T> lu_;
+  std::vector<int> pivots_;
+  std::vector<T> scales_;
+  int sign_;
+  bool singular_;
+
+  bool negligible(int k) const noexcept;
+  void substitute(S21BasicMatrix<T>& x) const noexcept;
+};
+
+using S21LU = S21BasicLU<double>;
+
+extern template class S21BasicLU<float>;
+extern template class S21BasicLU<double>;
+extern template class S21BasicLU<long double>;
+
+#endif  // S21_MATRIX_LU_H_
@@ -0,0 +1,293 @@
+#include "s21_matrix_ooc.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "s21_matrix_gemm.h"
+#include "s21_matrix_io.h"
+
+namespace {
+
+constexpr int kLanes = S21Allocator::kAlignment / sizeof(double);
+// Result tiles narrower or shorter than this are only used when the budget
+// leaves no other choice: A or B would be re-read too many times.
+constexpr int kMinTile = 64;
+constexpr int kMaxDepth = 256;
+constexpr std::size_t kHashChunk = std::size_t{4} << 20;
+
+int roundUp(const int value) { return (value + kLanes - 1) / kLanes * kLanes; }
+
+// Elements held by one result tile plus two A and two B tiles.
+std::size_t tileElements(const int rows, const int ldc, const int cols,
+                         const int depth) {
+  return static_cast<std::size_t>(rows) * ldc +
+         2 * static_cast<std::size_t>(depth) * (rows + cols);
+}
+
+void writeAll(const int fd, const void* data, std::size_t bytes,
+              off_t offset) {
+  const char* ptr = static_cast<const char*>(data);
+  while (bytes > 0) {
+    const ssize_t done = pwrite(fd, ptr, bytes, offset);
+    if (done <= 0) {
+      throw std::runtime_error("s21_multiply_files: cannot write result");
+    }
+    ptr += done;
+    bytes -= static_cast<std::size_t>(done);
+    offset += done;
+  }
+}
+
+class FileCloser {
+ public:
+  explicit FileCloser(const int fd) : fd_(fd) {}
+  ~FileCloser() { close(fd_); }
+
+ private:
+  int fd_;
+};
+
+}  // namespace
+
+S21OutOfCoreStats s21_multiply_files(const std::string& a_path,
+                                     const std::string& b_path,
+                                     const std::string& c_path,
+                                     const std::size_t memory_budget) {
+  const S21MappedMatrix a = S21MappedMatrix::MapFile(a_path);
+  const S21MappedMatrix b = S21MappedMatrix::MapFile(b_path);
+
+  if (a.getCols() != b.getRows()) {
+    throw std::domain_error("s21_multiply_files: cannot multiply matrices");
+  }
+
+  const int m = a.getRows(), n = b.getCols(), k = a.getCols();
+  const int c_stride = roundUp(n);
+  const std::size_t budget = memory_budget / sizeof(double);
+
+  // Widest result tile first: full-width tiles are written sequentially
+  // and B is re-read once per row band, so shrink the band height down to
+  // kMinTile before narrowing the tile, and the depth last.
+  S21OutOfCoreStats stats = {};
+  int depth = std::min(k, kMaxDepth), cols = n, rows = 0;
+  for (;;) {
+    const int ldc = cols == n ? c_stride : cols;
+    const std::size_t fixed = 2 * static_cast<std::size_t>(depth) * cols;
+    const std::size_t per_row = ldc + 2 * static_cast<std::size_t>(depth);
+    rows = budget > fixed
+               ? static_cast<int>(
+                     std::min<std::size_t>((budget - fixed) / per_row, m))
+               : 0;
+    if (rows >= std::min(m, kMinTile)) {
+      break;
+    }
+    if (cols > kMinTile) {
+      cols = roundUp(cols / 2);
+    } else if (depth > kLanes) {
+      depth = std::max(kLanes, depth / 2);
+    } else if (cols > kLanes) {
+      cols = roundUp(cols / 2);
+    } else if (rows >= 1) {
+      break;
+    } else {
+      throw std::invalid_argument("s21_multiply_files: budget is too small");
+    }
+  }
+  const bool full_width = cols == n;
+  const int ldc = full_width ? c_stride : cols;
+  stats.tile_rows = rows;
+  stats.tile_cols = cols;
+  stats.tile_depth = depth;
+  stats.buffer_bytes = sizeof(double) * tileElements(rows, ldc, cols, depth);
+
+  const int fd = open(c_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    throw std::runtime_error("s21_multiply_files: cannot open " + c_path);
+  }
+  FileCloser closer(fd);
+
+  const off_t payload = sizeof(S21MatrixFileHeader);
+  const std::uint64_t payload_bytes =
+      sizeof(double) * static_cast<std::uint64_t>(m) * c_stride;
+  if (ftruncate(fd, payload + static_cast<off_t>(payload_bytes)) != 0) {
+    throw std::runtime_error("s21_multiply_files: cannot resize " + c_path);
+  }
+
+  const int row_tiles = (m + rows - 1) / rows;
+  const int col_tiles = (n + cols - 1) / cols;
+  const int depth_tiles = (k + depth - 1) / depth;
+  const int steps = row_tiles * col_tiles * depth_tiles;
+
+  // Step s multiplies A tile (ti, tp) by B tile (tp, tj) with tp fastest.
+  struct Slot {
+    std::vector<double> a, b;
+  };
+  Slot slots[2];
+  for (Slot& slot : slots) {
+    slot.a.resize(static_cast<std::size_t>(rows) * depth);
+    slot.b.resize(static_cast<std::size_t>(depth) * cols);
+  }
+  std::vector<double> c(static_cast<std::size_t>(rows) * ldc);
+
+  std::mutex mutex;
+  std::condition_variable changed;
+  int loaded = 0, consumed = 0;
+  bool stop = false;
+  std::exception_ptr error;
+
+  std::thread loader([&] {
+    try {
+      for (int s = 0; s < steps; ++s) {
+        {
+          std::unique_lock<std::mutex> lock(mutex);
+          changed.wait(lock, [&] { return stop || (loaded - consumed < 2); });
+          if (stop) {
+            return;
+          }
+        }
+
+        const int tp = s % depth_tiles;
+        const int tj = s / depth_tiles % col_tiles;
+        const int ti = s / depth_tiles / col_tiles;
+        const int i0 = ti * rows, j0 = tj * cols, p0 = tp * depth;
+        const int mi = std::min(rows, m - i0);
+        const int nj = std::min(cols, n - j0);
+        const int kp = std::min(depth, k - p0);
+        Slot& slot = slots[s % 2];
+
+        for (int i = 0; i < mi; ++i) {
+          std::memcpy(&slot.a[static_cast<std::size_t>(i) * depth],
+                      a.getData() +
+                          static_cast<std::size_t>(i0 + i) * a.getStride() +
+                          p0,
+                      sizeof(double) * kp);
+        }
+        for (int p = 0; p < kp; ++p) {
+          std::memcpy(&slot.b[static_cast<std::size_t>(p) * cols],
+                      b.getData() +
+                          static_cast<std::size_t>(p0 + p) * b.getStride() +
+                          j0,
+                      sizeof(double) * nj);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.bytes_read += sizeof(double) * (static_cast<std::uint64_t>(mi) +
+                                              static_cast<std::uint64_t>(nj)) *
+                            kp;
+        ++loaded;
+        changed.notify_all();
+      }
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex);
+      error = std::current_exception();
+      stop = true;
+      changed.notify_all();
+    }
+  });
+
+  auto finish = [&] {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stop = true;
+      changed.notify_all();
+    }
+    loader.join();
+  };
+
+  std::uint64_t hash = S21MatrixFileHeader::kChecksumSeed;
+  try {
+    for (int s = 0; s < steps; ++s) {
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [&] { return error || (loaded > s); });
+        if (error) {
+          std::rethrow_exception(error);
+        }
+      }
+
+      const int tp = s % depth_tiles;
+      const int tj = s / depth_tiles % col_tiles;
+      const int ti = s / depth_tiles / col_tiles;
+      const int i0 = ti * rows, j0 = tj * cols, p0 = tp * depth;
+      const int mi = std::min(rows, m - i0);
+      const int nj = std::min(cols, n - j0);
+      const int kp = std::min(depth, k - p0);
+      const Slot& slot = slots[s % 2];
+
+      if (tp == 0) {
+        std::fill(c.begin(), c.end(), 0);
+      }
+      s21_gemm(mi, nj, kp, slot.a.data(), depth, slot.b.data(), cols,
+               c.data(), ldc);
+
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++consumed;
+        changed.notify_all();
+      }
+
+      if (tp != depth_tiles - 1) {
+        continue;
+      }
+
+      if (full_width) {
+        const std::size_t bytes = sizeof(double) * mi * ldc;
+        writeAll(fd, c.data(), bytes,
+                 payload + static_cast<off_t>(sizeof(double)) * i0 * c_stride);
+        hash = s21_checksum(c.data(), bytes, hash);
+        stats.bytes_written += bytes;
+      } else {
+        for (int i = 0; i < mi; ++i) {
+          writeAll(fd, &c[static_cast<std::size_t>(i) * ldc],
+                   sizeof(double) * nj,
+                   payload + static_cast<off_t>(sizeof(double)) *
+                                 ((static_cast<off_t>(i0) + i) * c_stride +
+                                  j0));
+        }
+        stats.bytes_written += sizeof(double) * mi * nj;
+      }
+    }
+  } catch (...) {
+    finish();
+    throw;
+  }
+  finish();
+
+  // Narrow tiles were written out of order, so hash the result back.
+  if (!full_width) {
+    std::vector<double>().swap(c);
+    for (Slot& slot : slots) {
+      std::vector<double>().swap(slot.a);
+      std::vector<double>().swap(slot.b);
+    }
+    const std::size_t chunk_bytes = std::max<std::size_t>(
+        std::min(memory_budget, kHashChunk) / sizeof(double) * sizeof(double),
+        sizeof(double));
+    std::vector<char> chunk(
+        std::min<std::uint64_t>(chunk_bytes, payload_bytes));
+    for (std::uint64_t done = 0; done < payload_bytes;) {
+      const std::size_t bytes =
+          std::min<std::uint64_t>(chunk.size(), payload_bytes - done);
+      if (pread(fd, chunk.data(), bytes, payload + static_cast<off_t>(done)) !=
+          static_cast<ssize_t>(bytes)) {
+        throw std::runtime_error("s21_multiply_files: cannot read result");
+      }
+      hash = s21_checksum(chunk.data(), bytes, hash);
+      done += bytes;
+    }
+  }
+
+  const S21MatrixFileHeader header =
+      S21MatrixFileHeader::Make(m, n, c_stride, hash);
+  writeAll(fd, &header, sizeof(header), 0);
+  stats.bytes_written += sizeof(header);
+
+  return stats;
+}
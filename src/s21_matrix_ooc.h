@@ -0,0 +1,41 @@
+#ifndef S21_MATRIX_OOC_H_
+#define S21_MATRIX_OOC_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Memory budget of s21_multiply_files() when none is given, in bytes.
+#define S21_OOC_DEFAULT_BUDGET (std::size_t{256} << 20)
+
+struct S21OutOfCoreStats {
+  // Tile shape: result tiles are tile_rows x tile_cols and each step
+  // multiplies a tile_rows x tile_depth block of A by a tile_depth x
+  // tile_cols block of B.
+  int tile_rows, tile_cols, tile_depth;
+  // Bytes copied out of the mapped operands and written to the result.
+  std::uint64_t bytes_read, bytes_written;
+  // Tile buffers allocated, never more than the budget.
+  std::size_t buffer_bytes;
+};
+
+// C = A * B for matrices stored in files written by S21Matrix::Save; the
+// result is written to c_path in the same format. Only a few tiles are
+// resident at a time, so the operands may be far larger than memory.
+//
+// A and B are mapped read-only. A loader thread copies the next A and B
+// tiles out of the mappings (which is where the disk reads happen) while
+// the calling thread multiplies the current pair with s21_gemm(), so I/O
+// and compute overlap. Result tiles are as wide as the budget allows;
+// full-width tiles are written sequentially with the checksum computed on
+// the fly. Otherwise the result is hashed in one final pass.
+//
+// Throws std::domain_error on mismatched dimensions, std::invalid_argument
+// if memory_budget cannot hold the smallest tiles and std::runtime_error
+// on I/O errors.
+S21OutOfCoreStats s21_multiply_files(
+    const std::string& a_path, const std::string& b_path,
+    const std::string& c_path,
+    const std::size_t memory_budget = S21_OOC_DEFAULT_BUDGET);
+
+#endif  // S21_MATRIX_OOC_H_
@@ -1,51 +1,225 @@
 #include "s21_matrix_oop.h"
 
-double** S21Matrix::allocate(const int rows, const int cols) {
-  double** matrix = new double*[rows];
-  if (matrix == nullptr) {
-    throw std::bad_alloc();
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "s21_matrix_gemm.h"
+#include "s21_matrix_lu.h"
+#include "s21_matrix_parallel.h"
+#include "s21_matrix_simd.h"
+#include "s21_matrix_stats.h"
+
+namespace {
+
+// Element-wise kernels with the S21SimdKernels signatures. Plain loops the
+// compiler vectorizes for float and long double; double goes through the
+// runtime-dispatched SIMD set.
+template <typename T>
+struct Kernels {
+  static void add(T* dst, const T* src, const int rows, const int cols,
+                  const int dst_stride, const int src_stride) {
+    for (int i = 0; i < rows; ++i, dst += dst_stride, src += src_stride) {
+      for (int j = 0; j < cols; ++j) {
+        dst[j] += src[j];
+      }
+    }
   }
 
-  int k = 0;
+  static void sub(T* dst, const T* src, const int rows, const int cols,
+                  const int dst_stride, const int src_stride) {
+    for (int i = 0; i < rows; ++i, dst += dst_stride, src += src_stride) {
+      for (int j = 0; j < cols; ++j) {
+        dst[j] -= src[j];
+      }
+    }
+  }
 
-  try {
-    for (int i = 0; i < rows; ++i) {
-      matrix[i] = new double[cols];
-      if (matrix[i] == nullptr) {
-        k = i;
-        throw std::bad_alloc();
+  static void scale(T* dst, const T num, const int rows, const int cols,
+                    const int dst_stride) {
+    for (int i = 0; i < rows; ++i, dst += dst_stride) {
+      for (int j = 0; j < cols; ++j) {
+        dst[j] *= num;
       }
+    }
+  }
+
+  // Compares a whole row before testing, so the row loop vectorizes; the
+  // early exit happens between rows.
+  static bool equal(const T* a, const T* b, const int rows, const int cols,
+                    const int a_stride, const int b_stride, const T eps) {
+    for (int i = 0; i < rows; ++i, a += a_stride, b += b_stride) {
+      bool differs = false;
       for (int j = 0; j < cols; ++j) {
-        matrix[i][j] = 0;
+        differs |= std::abs(a[j] - b[j]) > eps;
+      }
+      if (differs) {
+        return false;
       }
     }
-  } catch (...) {
-    for (int i = 0; i < k; ++i) {
-      if (matrix[i] != nullptr) {
-        delete[] matrix[i];
+    return true;
+  }
+
+  static void transpose(T* dst, const T* src, const int rows, const int cols,
+                        const int dst_stride, const int src_stride) {
+    for (int i = 0; i < rows; ++i, src += src_stride) {
+      for (int j = 0; j < cols; ++j) {
+        dst[j * dst_stride + i] = src[j];
       }
     }
-    delete[] matrix;
-    throw;
   }
+};
 
-  return matrix;
+template <>
+struct Kernels<double> {
+  static void add(double* dst, const double* src, const int rows,
+                  const int cols, const int dst_stride, const int src_stride) {
+    s21_simd_kernels().add(dst, src, rows, cols, dst_stride, src_stride);
+  }
+
+  static void sub(double* dst, const double* src, const int rows,
+                  const int cols, const int dst_stride, const int src_stride) {
+    s21_simd_kernels().sub(dst, src, rows, cols, dst_stride, src_stride);
+  }
+
+  static void scale(double* dst, const double num, const int rows,
+                    const int cols, const int dst_stride) {
+    s21_simd_kernels().scale(dst, num, rows, cols, dst_stride);
+  }
+
+  static bool equal(const double* a, const double* b, const int rows,
+                    const int cols, const int a_stride, const int b_stride,
+                    const double eps) {
+    return s21_simd_kernels().equal(a, b, rows, cols, a_stride, b_stride,
+                                    eps);
+  }
+
+  static void transpose(double* dst, const double* src, const int rows,
+                        const int cols, const int dst_stride,
+                        const int src_stride) {
+    s21_simd_kernels().transpose(dst, src, rows, cols, dst_stride,
+                                 src_stride);
+  }
+};
+
+// Blocks of at most kTransposeLeaf x kTransposeLeaf elements are handed to
+// the transpose kernel: source and destination then sit in L1 together.
+constexpr int kTransposeLeaf = 32;
+
+// Cache-oblivious transpose: halves the longer side (on a multiple of the
+// leaf, so leaves stay aligned with the register tiles) until the block
+// fits in L1, which keeps every cache level busy without tuning for it.
+template <typename T>
+void transposeBlock(T* dst, const T* src, const int rows, const int cols,
+                    const int dst_stride, const int src_stride) {
+  if ((rows <= kTransposeLeaf) && (cols <= kTransposeLeaf)) {
+    Kernels<T>::transpose(dst, src, rows, cols, dst_stride, src_stride);
+    return;
+  }
+
+  const int longer = std::max(rows, cols);
+  const int half =
+      (longer / 2 + kTransposeLeaf - 1) / kTransposeLeaf * kTransposeLeaf;
+
+  if (rows >= cols) {
+    transposeBlock(dst, src, half, cols, dst_stride, src_stride);
+    transposeBlock(dst + half, src + half * src_stride, rows - half, cols,
+                   dst_stride, src_stride);
+  } else {
+    transposeBlock(dst, src, rows, half, dst_stride, src_stride);
+    transposeBlock(dst + half * dst_stride, src + half, rows, cols - half,
+                   dst_stride, src_stride);
+  }
+}
+
+// Transposes tiles (i, j) and (j, i) of a square matrix into each other's
+// place through a leaf-sized buffer; i == j transposes a diagonal tile.
+template <typename T>
+void swapTransposedTiles(T* matrix, const int size, const int stride,
+                         const int i, const int j, T* buffer) {
+  const int rows = std::min(kTransposeLeaf, size - i);
+  const int cols = std::min(kTransposeLeaf, size - j);
+  T* upper = matrix + i * stride + j;
+  T* lower = matrix + j * stride + i;
+
+  Kernels<T>::transpose(buffer, upper, rows, cols, kTransposeLeaf, stride);
+  if (i != j) {
+    Kernels<T>::transpose(upper, lower, cols, rows, stride, stride);
+  }
+  for (int r = 0; r < cols; ++r) {
+    std::copy(buffer + r * kTransposeLeaf, buffer + r * kTransposeLeaf + rows,
+              lower + r * stride);
+  }
 }
 
-void S21Matrix::deallocate(const int rows) {
-  for (int i = 0; i < rows; ++i) {
-    delete[] matrix_[i];
+// In-place transpose of a packed rows x cols array by following the cycles
+// of the permutation k -> k * rows mod (rows * cols - 1); visited holds one
+// bit per element.
+template <typename T>
+void transposeCycles(T* data, const int rows, const int cols) {
+  const long last = static_cast<long>(rows) * cols - 1;
+  std::vector<bool> visited(last + 1);
+
+  for (long start = 1; start < last; ++start) {
+    if (visited[start]) {
+      continue;
+    }
+
+    T carried = data[start];
+    long k = start;
+    do {
+      k = k * rows % last;
+      std::swap(data[k], carried);
+      visited[k] = true;
+    } while (k != start);
   }
-  delete[] matrix_;
 }
 
-S21Matrix::S21Matrix() {
+}  // namespace
+
+template <typename T>
+int S21BasicMatrix<T>::calcStride(const int cols) noexcept {
+  const int step = static_cast<int>(kAlignment / sizeof(T));
+  return (cols + step - 1) / step * step;
+}
+
+template <typename T>
+T* S21BasicMatrix<T>::allocate(const int rows, const int stride) const {
+  const std::size_t size =
+      static_cast<std::size_t>(rows) * static_cast<std::size_t>(stride);
+
+  T* matrix = static_cast<T*>(allocator_->Allocate(size * sizeof(T)));
+  S21_STATS_ALLOC(size * sizeof(T));
+
+  std::memset(matrix, 0, size * sizeof(T));
+
+  return matrix;
+}
+
+template <typename T>
+void S21BasicMatrix<T>::deallocate(T* matrix, const int rows,
+                                   const int stride) const noexcept {
+  allocator_->Deallocate(matrix, sizeof(T) * static_cast<std::size_t>(rows) *
+                                     static_cast<std::size_t>(stride));
+}
+
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix() {
+  allocator_ = &s21_get_allocator();
   rows_ = 1;
   cols_ = 1;
-  matrix_ = allocate(rows_, cols_);
+  stride_ = calcStride(cols_);
+  matrix_ = allocate(rows_, stride_);
 }
 
-S21Matrix::S21Matrix(int rows, int cols) {
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(int rows, int cols)
+    : S21BasicMatrix(rows, cols, s21_get_allocator()) {}
+
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(int rows, int cols,
+                                  S21Allocator& allocator) {
   if (rows < 1) {
     throw std::invalid_argument("Invalid rows argument");
   }
@@ -54,44 +228,84 @@ S21Matrix::S21Matrix(int rows, int cols) {
     throw std::invalid_argument("Invalid cols argument");
   }
 
+  allocator_ = &allocator;
   rows_ = rows;
   cols_ = cols;
-  matrix_ = allocate(rows_, cols_);
+  stride_ = calcStride(cols_);
+  matrix_ = allocate(rows_, stride_);
 }
 
-S21Matrix::~S21Matrix() {
+template <typename T>
+S21BasicMatrix<T>::~S21BasicMatrix() {
   if (matrix_) {
-    deallocate(rows_);
+    deallocate(matrix_, rows_, stride_);
   }
 }
 
-S21Matrix::S21Matrix(const S21Matrix& other) {
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(const S21BasicMatrix& other) {
+  allocator_ = &s21_get_allocator();
   rows_ = other.rows_;
   cols_ = other.cols_;
-  matrix_ = allocate(rows_, cols_);
+  stride_ = other.stride_;
+  matrix_ = allocate(rows_, stride_);
 
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] = other.matrix_[i][j];
-    }
-  }
+  std::memcpy(matrix_, other.matrix_,
+              sizeof(T) * static_cast<std::size_t>(rows_) * stride_);
 }
 
-S21Matrix::S21Matrix(S21Matrix&& other) {
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(S21BasicMatrix&& other) noexcept {
+  allocator_ = other.allocator_;
   rows_ = other.rows_;
   cols_ = other.cols_;
+  stride_ = other.stride_;
   matrix_ = other.matrix_;
 
   other.rows_ = 0;
   other.cols_ = 0;
+  other.stride_ = 0;
   other.matrix_ = nullptr;
 }
 
-int S21Matrix::getRows() const { return rows_; }
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(const view_type& view)
+    : S21BasicMatrix(view.getRows(), view.getCols()) {
+  if (view.transposed_) {
+    for (int i = 0; i < rows_; ++i) {
+      for (int j = 0; j < cols_; ++j) {
+        matrix_[i * stride_ + j] = view.At(i, j);
+      }
+    }
+    return;
+  }
+
+  // Each source row is at most two contiguous runs around the skipped column.
+  const int skip_col = view.skip_col_ < 0 ? cols_ : view.skip_col_;
+  for (int i = 0; i < rows_; ++i) {
+    const int row = i + ((view.skip_row_ >= 0) && (i >= view.skip_row_));
+    const T* src = view.data_ + row * view.stride_;
+    T* dst = matrix_ + i * stride_;
+    std::memcpy(dst, src, sizeof(T) * skip_col);
+    std::memcpy(dst + skip_col, src + skip_col + 1,
+                sizeof(T) * (cols_ - skip_col));
+  }
+}
+
+template <typename T>
+int S21BasicMatrix<T>::getRows() const { return rows_; }
+
+template <typename T>
+int S21BasicMatrix<T>::getCols() const { return cols_; }
 
-int S21Matrix::getCols() const { return cols_; }
+template <typename T>
+int S21BasicMatrix<T>::getStride() const { return stride_; }
 
-void S21Matrix::setRows(const int rows) {
+template <typename T>
+S21Allocator& S21BasicMatrix<T>::getAllocator() const { return *allocator_; }
+
+template <typename T>
+void S21BasicMatrix<T>::setRows(const int rows) {
   if (rows < 1) {
     throw std::invalid_argument("Invalid rows argument");
   }
@@ -100,20 +314,19 @@ void S21Matrix::setRows(const int rows) {
     return;
   }
 
-  double** new_matrix = allocate(rows, cols_);
+  T* new_matrix = allocate(rows, stride_);
 
-  for (int i = 0; i < rows && i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      new_matrix[i][j] = matrix_[i][j];
-    }
-  }
+  const int common_rows = rows < rows_ ? rows : rows_;
+  std::memcpy(new_matrix, matrix_,
+              sizeof(T) * static_cast<std::size_t>(common_rows) * stride_);
 
-  deallocate(rows_);
+  deallocate(matrix_, rows_, stride_);
   matrix_ = new_matrix;
   rows_ = rows;
 }
 
-void S21Matrix::setCols(const int cols) {
+template <typename T>
+void S21BasicMatrix<T>::setCols(const int cols) {
   if (cols < 1) {
     throw std::invalid_argument("Invalid cols argument");
   }
@@ -122,20 +335,24 @@ void S21Matrix::setCols(const int cols) {
     return;
   }
 
-  double** new_matrix = allocate(rows_, cols);
+  const int stride = calcStride(cols);
+  T* new_matrix = allocate(rows_, stride);
 
+  const int common_cols = cols < cols_ ? cols : cols_;
   for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_ && j < cols; ++j) {
-      new_matrix[i][j] = matrix_[i][j];
-    }
+    std::memcpy(new_matrix + static_cast<std::size_t>(i) * stride,
+                matrix_ + static_cast<std::size_t>(i) * stride_,
+                sizeof(T) * common_cols);
   }
 
-  deallocate(rows_);
+  deallocate(matrix_, rows_, stride_);
   matrix_ = new_matrix;
   cols_ = cols;
+  stride_ = stride;
 }
 
-double S21Matrix::operator()(const int i, const int j) const {
+template <typename T>
+T S21BasicMatrix<T>::operator()(const int i, const int j) const {
   if ((i < 0) || (i > rows_ - 1)) {
     throw std::out_of_range("i argument out of range");
   }
@@ -144,10 +361,11 @@ double S21Matrix::operator()(const int i, const int j) const {
     throw std::out_of_range("j argument out of range");
   }
 
-  return matrix_[i][j];
+  return matrix_[i * stride_ + j];
 }
 
-double& S21Matrix::operator()(const int i, const int j) {
+template <typename T>
+T& S21BasicMatrix<T>::operator()(const int i, const int j) {
   if ((i < 0) || (i > rows_ - 1)) {
     throw std::out_of_range("i argument out of range");
   }
@@ -156,27 +374,43 @@ double& S21Matrix::operator()(const int i, const int j) {
     throw std::out_of_range("j argument out of range");
   }
 
-  double& value = matrix_[i][j];
+  T& value = matrix_[i * stride_ + j];
 
   return value;
 }
 
-void S21Matrix::MulNumber(const double num) noexcept {
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] *= num;
-    }
-  }
+template <typename T>
+void S21BasicMatrix<T>::MulNumber(const T num) noexcept {
+  S21_STATS_OP(S21Op::kMulNumber, static_cast<double>(rows_) * cols_);
+  s21_parallel_rows(rows_, cols_, [&](int begin, int end) {
+    Kernels<T>::scale(matrix_ + begin * stride_, num, end - begin, cols_,
+                      stride_);
+  });
 }
 
-bool S21Matrix::EqMatrix(const S21Matrix& other) noexcept {
-  if ((rows_ != other.rows_) || (cols_ != other.cols_)) {
+template <typename T>
+bool S21BasicMatrix<T>::EqMatrix(const S21BasicMatrix& other) noexcept {
+  return EqMatrix(other.View());
+}
+
+template <typename T>
+bool S21BasicMatrix<T>::EqMatrix(const view_type& other) noexcept {
+  if ((rows_ != other.getRows()) || (cols_ != other.getCols())) {
     return false;
   }
 
+  S21_STATS_OP(S21Op::kEqMatrix, 0);
+
+  const T eps = S21Tolerance<T>::kEps;
+
+  if (other.isContiguous()) {
+    return Kernels<T>::equal(matrix_, other.getData(), rows_, cols_, stride_,
+                             other.getStride(), eps);
+  }
+
   for (int i = 0; i < rows_; ++i) {
     for (int j = 0; j < cols_; ++j) {
-      if (fabs(matrix_[i][j] - other.matrix_[i][j]) > EPS) {
+      if (std::abs(matrix_[i * stride_ + j] - other.At(i, j)) > eps) {
         return false;
       }
     }
@@ -185,63 +419,179 @@ bool S21Matrix::EqMatrix(const S21Matrix& other) noexcept {
   return true;
 }
 
-S21Matrix S21Matrix::Transpose() noexcept {
-  S21Matrix new_matrix(cols_, rows_);
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Transpose() noexcept {
+  S21_STATS_OP(S21Op::kTranspose, 0);
+  S21BasicMatrix new_matrix(cols_, rows_);
 
+  // Each task writes a band of rows of the result.
+  s21_parallel_rows(cols_, rows_, [&](int begin, int end) {
+    transposeBlock(new_matrix.matrix_ + begin * new_matrix.stride_,
+                   matrix_ + begin, rows_, end - begin, new_matrix.stride_,
+                   stride_);
+  });
+
+  return new_matrix;
+}
+
+template <typename T>
+void S21BasicMatrix<T>::TransposeInPlace() {
+  S21_STATS_OP(S21Op::kTranspose, 0);
+
+  if (rows_ == cols_) {
+    const int tiles = (rows_ + kTransposeLeaf - 1) / kTransposeLeaf;
+    s21_parallel_rows(tiles, static_cast<long>(rows_) * kTransposeLeaf,
+                      [&](int begin, int end) {
+                        alignas(64) T buffer[kTransposeLeaf * kTransposeLeaf];
+                        for (int i = begin; i < end; ++i) {
+                          for (int j = i; j < tiles; ++j) {
+                            swapTransposedTiles(
+                                matrix_, rows_, stride_, i * kTransposeLeaf,
+                                j * kTransposeLeaf, buffer);
+                          }
+                        }
+                      });
+    return;
+  }
+
+  const int stride = calcStride(rows_);
+
+  // The buffer can only be reused when the padded size stays the same.
+  if (static_cast<long>(cols_) * stride !=
+      static_cast<long>(rows_) * stride_) {
+    *this = Transpose();
+    return;
+  }
+
+  // Drop the row padding, permute the packed elements, then spread the
+  // rows out to the new stride from the back.
+  for (int i = 1; i < rows_; ++i) {
+    std::memmove(matrix_ + i * cols_, matrix_ + i * stride_,
+                 cols_ * sizeof(T));
+  }
+  transposeCycles(matrix_, rows_, cols_);
+  for (int i = cols_ - 1; i > 0; --i) {
+    std::memmove(matrix_ + i * stride, matrix_ + i * rows_,
+                 rows_ * sizeof(T));
+  }
   for (int i = 0; i < cols_; ++i) {
-    for (int j = 0; j < rows_; ++j) {
-      new_matrix.matrix_[i][j] = matrix_[j][i];
-    }
+    std::fill(matrix_ + i * stride + rows_, matrix_ + (i + 1) * stride, 0);
   }
 
-  return new_matrix;
+  std::swap(rows_, cols_);
+  stride_ = stride;
 }
 
-void S21Matrix::SumMatrix(const S21Matrix& other) {
-  if ((rows_ != other.rows_) || (cols_ != other.cols_)) {
+template <typename T>
+void S21BasicMatrix<T>::SumMatrix(const S21BasicMatrix& other) {
+  SumMatrix(other.View());
+}
+
+template <typename T>
+void S21BasicMatrix<T>::SumMatrix(const view_type& other) {
+  if ((rows_ != other.getRows()) || (cols_ != other.getCols())) {
     throw std::invalid_argument("SumMatrix: different dimensions");
   }
 
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] += other.matrix_[i][j];
-    }
+  S21_STATS_OP(S21Op::kSumMatrix, static_cast<double>(rows_) * cols_);
+
+  if (!other.isContiguous()) {
+    *this = *this + other;
+    return;
   }
+
+  s21_parallel_rows(rows_, cols_, [&](int begin, int end) {
+    Kernels<T>::add(matrix_ + begin * stride_,
+                    other.getData() + begin * other.getStride(), end - begin,
+                    cols_, stride_, other.getStride());
+  });
+}
+
+template <typename T>
+void S21BasicMatrix<T>::SubMatrix(const S21BasicMatrix& other) {
+  SubMatrix(other.View());
 }
 
-void S21Matrix::SubMatrix(const S21Matrix& other) {
-  if ((rows_ != other.rows_) || (cols_ != other.cols_)) {
+template <typename T>
+void S21BasicMatrix<T>::SubMatrix(const view_type& other) {
+  if ((rows_ != other.getRows()) || (cols_ != other.getCols())) {
     throw std::invalid_argument("SumMatrix: different dimensions");
   }
 
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] -= other.matrix_[i][j];
-    }
+  S21_STATS_OP(S21Op::kSubMatrix, static_cast<double>(rows_) * cols_);
+
+  if (!other.isContiguous()) {
+    *this = *this - other;
+    return;
   }
+
+  s21_parallel_rows(rows_, cols_, [&](int begin, int end) {
+    Kernels<T>::sub(matrix_ + begin * stride_,
+                    other.getData() + begin * other.getStride(), end - begin,
+                    cols_, stride_, other.getStride());
+  });
 }
 
-void S21Matrix::MulMatrix(const S21Matrix& other) {
-  if (other.rows_ != cols_) {
+template <typename T>
+void S21BasicMatrix<T>::MulMatrix(const S21BasicMatrix& other) {
+  MulMatrix(other.View());
+}
+
+template <typename T>
+void S21BasicMatrix<T>::MulMatrix(const view_type& other) {
+  if (other.getRows() != cols_) {
     throw std::domain_error("MulMatrix: cannot multiply matrices");
   }
 
-  double** new_matrix = allocate(rows_, other.cols_);
-
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < other.cols_; ++j) {
-      for (int k = 0; k < cols_; ++k) {
-        new_matrix[i][j] += matrix_[i][k] * other.matrix_[k][j];
-      }
-    }
+  if (!other.isContiguous()) {
+    MulMatrix(S21BasicMatrix(other));
+    return;
   }
 
-  setCols(other.cols_);
-  deallocate(rows_);
+  const int cols = other.getCols();
+  S21_STATS_OP(S21Op::kMulMatrix, 2.0 * rows_ * cols * cols_);
+  const int stride = calcStride(cols);
+  T* new_matrix = allocate(rows_, stride);
+
+  s21_gemm(rows_, cols, cols_, matrix_, stride_, other.getData(),
+           other.getStride(), new_matrix, stride);
+
+  deallocate(matrix_, rows_, stride_);
   matrix_ = new_matrix;
+  cols_ = cols;
+  stride_ = stride;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Minor(const int i, const int j) {
+  S21_STATS_OP(S21Op::kMinor, 0);
+  return S21BasicMatrix(MinorView(i, j));
+}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrix<T>::View() const noexcept {
+  return view_type(*this);
+}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrix<T>::Block(const int row, const int col,
+                                               const int rows,
+                                               const int cols) const {
+  if ((row < 0) || (rows < 1) || (row > rows_ - rows)) {
+    throw std::out_of_range("Block: rows out of range");
+  }
+
+  if ((col < 0) || (cols < 1) || (col > cols_ - cols)) {
+    throw std::out_of_range("Block: cols out of range");
+  }
+
+  return view_type(matrix_ + row * stride_ + col, rows, cols, stride_, -1, -1,
+                   false);
 }
 
-S21Matrix S21Matrix::Minor(const int i, const int j) {
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrix<T>::MinorView(const int i,
+                                                   const int j) const {
   if ((i < 0) || (i > rows_ - 1)) {
     throw std::out_of_range("Minor: i argument out of range");
   }
@@ -250,58 +600,77 @@ S21Matrix S21Matrix::Minor(const int i, const int j) {
     throw std::out_of_range("Minor: j argument out of range");
   }
 
-  S21Matrix minor(rows_ - 1, cols_ - 1);
-
-  for (int m = 0; m < rows_; ++m) {
-    for (int n = 0; n < cols_; ++n) {
-      if ((m < i) && (n < j)) {
-        minor(m, n) = matrix_[m][n];
-      } else if ((m > i) && (n < j)) {
-        minor(m - 1, n) = matrix_[m][n];
-      } else if ((m < i) && (n > j)) {
-        minor(m, n - 1) = matrix_[m][n];
-      } else if ((m > i) && (n > j)) {
-        minor(m - 1, n - 1) = matrix_[m][n];
-      }
-    }
-  }
+  return view_type(matrix_, rows_ - 1, cols_ - 1, stride_, i, j, false);
+}
 
-  return minor;
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrix<T>::TransposeView() const noexcept {
+  return View().Transpose();
 }
 
-double S21Matrix::Determinant() {
+template <typename T>
+T S21BasicMatrix<T>::Determinant() {
   if (rows_ != cols_) {
     throw std::domain_error("Determinant: matrix must be squared");
   }
 
-  double det = 0;
-
-  if (rows_ == 1) {
-    det += matrix_[0][0];
-  } else {
-    for (int i = 0; i < cols_; ++i) {
-      S21Matrix minor = this->Minor(0, i);
-      det += minor.Determinant() * pow(-1, i) * matrix_[0][i];
-    }
-  }
+  S21_STATS_OP(S21Op::kDeterminant, 2.0 / 3 * rows_ * rows_ * rows_);
 
-  return det;
+  return S21BasicLU<T>(*this).Determinant();
 }
 
-S21Matrix S21Matrix::CalcComplements() {
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::CalcComplements() {
   if (rows_ != cols_) {
     throw std::domain_error("CalcComplements: matrix must be squared");
   }
 
-  S21Matrix new_matrix(rows_, cols_);
+  S21_STATS_OP(S21Op::kCalcComplements, 2.0 * rows_ * rows_ * rows_);
+
+  S21BasicMatrix new_matrix(rows_, cols_);
 
   if (rows_ == 1) {
     new_matrix(0, 0) = 1;
-  } else {
+    return new_matrix;
+  }
+
+  S21BasicLU<T> lu(*this);
+
+  if (!lu.IsSingular()) {
+    // C = det(A) * (A^-1)^T
+    const T det = lu.Determinant();
+    S21BasicMatrix inverse = lu.Inverse();
+    for (int i = 0; i < rows_; ++i) {
+      for (int j = 0; j < cols_; ++j) {
+        new_matrix.matrix_[i * new_matrix.stride_ + j] =
+            det * inverse.matrix_[j * inverse.stride_ + i];
+      }
+    }
+    return new_matrix;
+  }
+
+  // Rank n - 1: C = c * y * x^T, where x and y span the right and left null
+  // spaces. The scale c comes from one explicitly computed cofactor. For
+  // lower rank every cofactor vanishes.
+  std::vector<T> x, y;
+  if (lu.NullVectors(x, y)) {
+    int m = 0, n = 0;
+    for (int i = 1; i < rows_; ++i) {
+      if (std::abs(y[i]) > std::abs(y[m])) {
+        m = i;
+      }
+      if (std::abs(x[i]) > std::abs(x[n])) {
+        n = i;
+      }
+    }
+
+    const T cofactor =
+        this->Minor(m, n).Determinant() * ((m + n) % 2 ? -1 : 1);
+    const T c = cofactor / (y[m] * x[n]);
+
     for (int i = 0; i < rows_; ++i) {
       for (int j = 0; j < cols_; ++j) {
-        S21Matrix minor = this->Minor(i, j);
-        new_matrix.matrix_[i][j] = minor.Determinant() * pow(-1, i + j);
+        new_matrix.matrix_[i * new_matrix.stride_ + j] = c * y[i] * x[j];
       }
     }
   }
@@ -309,92 +678,117 @@ S21Matrix S21Matrix::CalcComplements() {
   return new_matrix;
 }
 
-S21Matrix S21Matrix::InverseMatrix() {
-  double det = this->Determinant();
-
-  if (fabs(det) < EPS) {
-    throw std::domain_error("InverseMatrix: matrix determinant is zero");
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::InverseMatrix() {
+  if (rows_ != cols_) {
+    throw std::domain_error("InverseMatrix: matrix must be squared");
   }
 
-  S21Matrix compl_matrix = this->CalcComplements();
+  S21_STATS_OP(S21Op::kInverseMatrix, 2.0 * rows_ * rows_ * rows_);
 
-  S21Matrix transp_matrix = compl_matrix.Transpose();
+  S21BasicLU<T> lu(*this);
 
-  transp_matrix.MulNumber(1 / det);
+  if (lu.IsSingular()) {
+    throw std::domain_error("InverseMatrix: matrix determinant is zero");
+  }
 
-  return transp_matrix;
+  return lu.Inverse();
 }
 
-S21Matrix& S21Matrix::operator+=(const S21Matrix& other) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator+=(const S21BasicMatrix& other) {
   this->SumMatrix(other);
   return *this;
 }
 
-S21Matrix& S21Matrix::operator-=(const S21Matrix& other) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator-=(const S21BasicMatrix& other) {
   this->SubMatrix(other);
   return *this;
 }
 
-S21Matrix& S21Matrix::operator*=(const S21Matrix& other) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator*=(const S21BasicMatrix& other) {
   this->MulMatrix(other);
   return *this;
 }
 
-S21Matrix& S21Matrix::operator*=(const double& num) noexcept {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator*=(const T& num) noexcept {
   this->MulNumber(num);
   return *this;
 }
 
-bool S21Matrix::operator==(const S21Matrix& other) noexcept {
+template <typename T>
+bool S21BasicMatrix<T>::operator==(const S21BasicMatrix& other) noexcept {
   return this->EqMatrix(other);
 }
 
-S21Matrix S21Matrix::operator+(const S21Matrix& other) {
-  S21Matrix res(*this);
-  res += other;
-  return res;
-}
-
-S21Matrix S21Matrix::operator-(const S21Matrix& other) {
-  S21Matrix res(*this);
-  res -= other;
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::operator*(const S21BasicMatrix& other) & {
+  S21BasicMatrix res(*this);
+  res *= other;
   return res;
 }
 
-S21Matrix S21Matrix::operator*(const S21Matrix& other) {
-  S21Matrix res(*this);
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::operator*(
+    const S21BasicMatrix& other) && {
+  S21BasicMatrix res(std::move(*this));
   res *= other;
   return res;
 }
 
-S21Matrix S21Matrix::operator*(const double& num) noexcept {
-  S21Matrix res(*this);
-  res *= num;
-  return res;
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(const S21BasicMatrix& other) {
+  if (this == &other) {
+    return *this;
+  }
+
+  if ((matrix_ == nullptr) || (rows_ != other.rows_) ||
+      (stride_ != other.stride_)) {
+    T* new_matrix = allocate(other.rows_, other.stride_);
+    if (matrix_) {
+      deallocate(matrix_, rows_, stride_);
+    }
+    matrix_ = new_matrix;
+  }
+
+  rows_ = other.rows_;
+  cols_ = other.cols_;
+  stride_ = other.stride_;
+
+  std::memcpy(matrix_, other.matrix_,
+              sizeof(T) * static_cast<std::size_t>(rows_) * stride_);
+
+  return *this;
 }
 
-S21Matrix& S21Matrix::operator=(const S21Matrix& other) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(
+    S21BasicMatrix&& other) noexcept {
   if (this == &other) {
     return *this;
   }
 
-  deallocate(rows_);
+  if (matrix_) {
+    deallocate(matrix_, rows_, stride_);
+  }
 
+  allocator_ = other.allocator_;
   rows_ = other.rows_;
   cols_ = other.cols_;
-  matrix_ = allocate(rows_, cols_);
+  stride_ = other.stride_;
+  matrix_ = other.matrix_;
 
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] = other.matrix_[i][j];
-    }
-  }
+  other.rows_ = 0;
+  other.cols_ = 0;
+  other.stride_ = 0;
+  other.matrix_ = nullptr;
 
   return *this;
 }
 
-S21Matrix operator*(const double& num, const S21Matrix& other) {
-  S21Matrix res(other);
-  res *= num;
-  return res;
-}
+template class S21BasicMatrix<float>;
+template class S21BasicMatrix<double>;
+template class S21BasicMatrix<long double>;
@@ -1,63 +1,232 @@
 #ifndef S21_MATRIX_OOP_H_
 #define S21_MATRIX_OOP_H_
 
-#define EPS 10E-7
-
+#include <cassert>
 #include <cmath>
+#include <cstddef>
 #include <iostream>
+#include <new>
 #include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "s21_matrix_alloc.h"
+#include "s21_matrix_iterator.h"
+
+// Tolerance of EqMatrix and of the singularity tests for element type T.
+// double keeps the former EPS of 1e-6; float and long double are scaled
+// to their precision.
+template <typename T>
+struct S21Tolerance {
+  static constexpr T kEps = static_cast<T>(1e-6);
+};
+
+template <>
+struct S21Tolerance<float> {
+  static constexpr float kEps = 1e-4f;
+};
+
+template <>
+struct S21Tolerance<long double> {
+  static constexpr long double kEps = 1e-9L;
+};
+
+// Base of all lazy expression nodes, see s21_matrix_expr.h.
+struct S21ExprTag {};
+
+template <typename T>
+class S21BasicMatrixView;
+template <typename T>
+class S21BasicLU;
+template <typename T>
+class S21ExprLeaf;
+
+// Dense row-major matrix of float, double or long double elements; the
+// library is compiled for exactly these three. Use the aliases below.
+template <typename T>
+class S21BasicMatrix {
+  static_assert(std::is_floating_point<T>::value,
+                "S21BasicMatrix: element type must be floating point");
+
+  template <typename U>
+  friend class S21BasicMatrix;
+  friend class S21BasicLU<T>;
+  friend class S21ExprLeaf<T>;
+  friend class S21BasicMatrixView<T>;
+  friend class S21SparseMatrix;
+
+  // Expressions are accepted only over the same element type.
+  template <typename E>
+  using EnableIfExpr =
+      std::enable_if_t<std::is_base_of<S21ExprTag, E>::value &&
+                       std::is_same<typename E::value_type, T>::value>;
 
-class S21Matrix {
  public:
+  using value_type = T;
+  using iterator = S21MatrixIterator<T>;
+  using const_iterator = S21MatrixIterator<const T>;
+  using view_type = S21BasicMatrixView<T>;
+
   // Constructors and deconstructors
-  S21Matrix();
-  S21Matrix(int rows, int cols);
-  S21Matrix(const S21Matrix& other);
-  S21Matrix(S21Matrix&& other);
-  ~S21Matrix();
+  S21BasicMatrix();
+  S21BasicMatrix(int rows, int cols);
+  S21BasicMatrix(int rows, int cols, S21Allocator& allocator);
+  S21BasicMatrix(const S21BasicMatrix& other);
+  S21BasicMatrix(S21BasicMatrix&& other) noexcept;
+  template <typename E, typename = EnableIfExpr<E>>
+  S21BasicMatrix(const E& expr);
+  S21BasicMatrix(const view_type& view);
+  // Element-wise conversion from another element type.
+  template <typename U,
+            typename = std::enable_if_t<!std::is_same<U, T>::value>>
+  explicit S21BasicMatrix(const S21BasicMatrix<U>& other);
+  ~S21BasicMatrix();
 
   // Accessors
   int getRows() const;
   int getCols() const;
+  int getStride() const;
+  S21Allocator& getAllocator() const;
+
+  // Raw access. Row i starts at data() + i * getStride(); the elements past
+  // getCols() in each row are padding. Indices are only checked (by assert)
+  // in builds without NDEBUG, so loops over these vectorize like loops over
+  // a plain array.
+  T* data() noexcept { return matrix_; }
+  const T* data() const noexcept { return matrix_; }
+  T* row(const int i) noexcept {
+    assert((i >= 0) && (i < rows_));
+    return matrix_ + i * stride_;
+  }
+  const T* row(const int i) const noexcept {
+    assert((i >= 0) && (i < rows_));
+    return matrix_ + i * stride_;
+  }
+  T& at_unchecked(const int i, const int j) noexcept {
+    assert((j >= 0) && (j < cols_));
+    return row(i)[j];
+  }
+  T at_unchecked(const int i, const int j) const noexcept {
+    assert((j >= 0) && (j < cols_));
+    return row(i)[j];
+  }
+
+  // Iterators visit the elements in row-major order without the padding.
+  iterator begin() noexcept { return iterator(matrix_, 0, cols_, stride_); }
+  iterator end() noexcept {
+    return iterator(matrix_ + rows_ * stride_, 0, cols_, stride_);
+  }
+  const_iterator begin() const noexcept { return cbegin(); }
+  const_iterator end() const noexcept { return cend(); }
+  const_iterator cbegin() const noexcept {
+    return const_iterator(matrix_, 0, cols_, stride_);
+  }
+  const_iterator cend() const noexcept {
+    return const_iterator(matrix_ + rows_ * stride_, 0, cols_, stride_);
+  }
 
   // Mutators
   void setRows(const int rows);
   void setCols(const int cols);
 
   // Functions
-  bool EqMatrix(const S21Matrix& other) noexcept;
-  void SumMatrix(const S21Matrix& other);
-  void SubMatrix(const S21Matrix& other);
-  void MulNumber(const double num) noexcept;
-  void MulMatrix(const S21Matrix& other);
-  S21Matrix Transpose() noexcept;
-  S21Matrix CalcComplements();
-  double Determinant();
-  S21Matrix InverseMatrix();
-  S21Matrix Minor(const int i, const int j);
+  bool EqMatrix(const S21BasicMatrix& other) noexcept;
+  bool EqMatrix(const view_type& other) noexcept;
+  void SumMatrix(const S21BasicMatrix& other);
+  void SumMatrix(const view_type& other);
+  void SubMatrix(const S21BasicMatrix& other);
+  void SubMatrix(const view_type& other);
+  void MulNumber(const T num) noexcept;
+  void MulMatrix(const S21BasicMatrix& other);
+  void MulMatrix(const view_type& other);
+  S21BasicMatrix Transpose() noexcept;
+  // Without a second buffer when the padded size allows. Square matrices
+  // swap tiles through a stack buffer and never allocate. A rectangular
+  // one is permuted in place when its transpose has the same padded size,
+  // cols * calcStride(rows) == rows * getStride() (7 x 14 doubles, say),
+  // which allocates a one-bit-per-element visited set. Any other shape
+  // falls back to Transpose().
+  void TransposeInPlace();
+  S21BasicMatrix CalcComplements();
+  T Determinant();
+  S21BasicMatrix InverseMatrix();
+  S21BasicMatrix Minor(const int i, const int j);
+
+  // Views
+  view_type View() const noexcept;
+  view_type Block(const int row, const int col, const int rows,
+                  const int cols) const;
+  view_type MinorView(const int i, const int j) const;
+  view_type TransposeView() const noexcept;
+
+  // Serialization, see s21_matrix_io.h. Available for float and double.
+  void Save(const std::string& path) const;
+  static S21BasicMatrix Load(const std::string& path);
 
   // Operators
-  S21Matrix operator+(const S21Matrix& other);
-  S21Matrix operator-(const S21Matrix& other);
-  S21Matrix operator*(const S21Matrix& other);
-  S21Matrix operator*(const double& num) noexcept;
-  bool operator==(const S21Matrix& other) noexcept;
-  S21Matrix& operator=(const S21Matrix& other);
-  S21Matrix& operator+=(const S21Matrix& other);
-  S21Matrix& operator-=(const S21Matrix& other);
-  S21Matrix& operator*=(const S21Matrix& other);
-  S21Matrix& operator*=(const double& num) noexcept;
-  double operator()(const int i, const int j) const;
-  double& operator()(const int i, const int j);
+  // operator+, operator- and operator* with a number are lazy, see
+  // s21_matrix_expr.h.
+  S21BasicMatrix operator*(const S21BasicMatrix& other) &;
+  S21BasicMatrix operator*(const S21BasicMatrix& other) &&;
+  bool operator==(const S21BasicMatrix& other) noexcept;
+  S21BasicMatrix& operator=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator=(S21BasicMatrix&& other) noexcept;
+  template <typename E, typename = EnableIfExpr<E>>
+  S21BasicMatrix& operator=(const E& expr);
+  S21BasicMatrix& operator+=(const S21BasicMatrix& other);
+  template <typename E, typename = EnableIfExpr<E>>
+  S21BasicMatrix& operator+=(const E& expr);
+  S21BasicMatrix& operator-=(const S21BasicMatrix& other);
+  template <typename E, typename = EnableIfExpr<E>>
+  S21BasicMatrix& operator-=(const E& expr);
+  S21BasicMatrix& operator*=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator*=(const T& num) noexcept;
+  T operator()(const int i, const int j) const;
+  T& operator()(const int i, const int j);
+  // m[i][j]: unchecked row access, see row().
+  T* operator[](const int i) noexcept { return row(i); }
+  const T* operator[](const int i) const noexcept { return row(i); }
 
  private:
-  int rows_, cols_;
-  double** matrix_;
+  // Rows are stored contiguously in one block aligned to kAlignment bytes.
+  // Each row is padded to stride_ elements so every row starts aligned.
+  // Buffers come from allocator_, which is the calling thread's current
+  // allocator at construction unless one is passed explicitly.
+  static constexpr std::size_t kAlignment = S21Allocator::kAlignment;
 
-  double** allocate(const int rows, const int cols);
-  void deallocate(const int rows);
+  int rows_, cols_, stride_;
+  T* matrix_;
+  S21Allocator* allocator_;
+
+  static int calcStride(const int cols) noexcept;
+  T* allocate(const int rows, const int stride) const;
+  void deallocate(T* matrix, const int rows, const int stride) const noexcept;
+
+  template <typename E>
+  void assignExpr(const E& expr);
 };
 
-S21Matrix operator*(const double& num, const S21Matrix& other);
+template <typename T>
+template <typename U, typename>
+S21BasicMatrix<T>::S21BasicMatrix(const S21BasicMatrix<U>& other)
+    : S21BasicMatrix(other.rows_, other.cols_) {
+  for (int i = 0; i < rows_; ++i) {
+    for (int j = 0; j < cols_; ++j) {
+      matrix_[i * stride_ + j] =
+          static_cast<T>(other.matrix_[i * other.stride_ + j]);
+    }
+  }
+}
+
+using S21Matrix = S21BasicMatrix<double>;
+using S21MatrixF = S21BasicMatrix<float>;
+using S21MatrixLD = S21BasicMatrix<long double>;
+
+extern template class S21BasicMatrix<float>;
+extern template class S21BasicMatrix<double>;
+extern template class S21BasicMatrix<long double>;
+
+#include "s21_matrix_expr.h"
+#include "s21_matrix_view.h"
 
 #endif  // S21_MATRIX_OOP_H_
\ No newline at end of file
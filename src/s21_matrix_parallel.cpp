@@ -0,0 +1,256 @@
+#include "s21_matrix_parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <stdexcept>
+
+namespace {
+
+// Work below this many element operations is not worth waking the pool.
+constexpr long kParallelThreshold = 1L << 16;
+
+thread_local bool in_parallel_region = false;
+
+int defaultThreads() noexcept {
+  const char* env = std::getenv("S21_MATRIX_NUM_THREADS");
+  if (env != nullptr) {
+    const int threads = std::atoi(env);
+    if (threads > 0) {
+      return threads;
+    }
+  }
+
+  const unsigned hardware = std::thread::hardware_concurrency();
+  return hardware > 0 ? static_cast<int>(hardware) : 1;
+}
+
+std::mutex pool_mutex;
+std::unique_ptr<S21ThreadPool> pool;
+std::atomic<S21Executor*> executor{nullptr};
+
+S21ThreadPool& defaultPool() {
+  std::lock_guard<std::mutex> lock(pool_mutex);
+  if (!pool) {
+    pool = std::make_unique<S21ThreadPool>(defaultThreads());
+  }
+  return *pool;
+}
+
+// Threads behind S21Executor::Post. There are at least two, so that
+// independent jobs overlap even on a single core. The dispatcher is never
+// destroyed and its threads are detached: a job left queued at exit is
+// dropped with the process instead of running during static destruction.
+class Dispatcher {
+ public:
+  Dispatcher() {
+    const int threads = std::max(2, defaultThreads());
+    for (int i = 0; i < threads; ++i) {
+      std::thread(&Dispatcher::Loop, this).detach();
+    }
+  }
+
+  void Push(std::function<void()> job) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      jobs_.push_back(std::move(job));
+    }
+    wake_.notify_one();
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::deque<std::function<void()>> jobs_;
+
+  void Loop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      wake_.wait(lock, [this] { return !jobs_.empty(); });
+
+      std::function<void()> job = std::move(jobs_.front());
+      jobs_.pop_front();
+      lock.unlock();
+      job();
+      lock.lock();
+    }
+  }
+};
+
+}  // namespace
+
+void S21Executor::Post(std::function<void()> job) {
+  static Dispatcher* const dispatcher = new Dispatcher;
+  dispatcher->Push(std::move(job));
+}
+
+S21ThreadPool::S21ThreadPool(const int threads)
+    : task_(nullptr),
+      count_(0),
+      next_(0),
+      done_(0),
+      active_(0),
+      generation_(0),
+      stop_(false) {
+  if (threads < 1) {
+    throw std::invalid_argument("S21ThreadPool: invalid threads argument");
+  }
+
+  for (int i = 1; i < threads; ++i) {
+    workers_.emplace_back(&S21ThreadPool::WorkerLoop, this);
+  }
+}
+
+S21ThreadPool::~S21ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  start_.notify_all();
+
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+}
+
+int S21ThreadPool::Concurrency() const noexcept {
+  return static_cast<int>(workers_.size()) + 1;
+}
+
+void S21ThreadPool::ParallelFor(const int count,
+                                const std::function<void(int)>& task) {
+  if (count <= 0) {
+    return;
+  }
+
+  if (workers_.empty() || (count == 1) || in_parallel_region) {
+    for (int i = 0; i < count; ++i) {
+      task(i);
+    }
+    return;
+  }
+
+  std::lock_guard<std::mutex> submit_lock(submit_mutex_);
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    task_ = &task;
+    count_ = count;
+    next_ = 0;
+    done_ = 0;
+    error_ = nullptr;
+    ++generation_;
+  }
+  start_.notify_all();
+
+  in_parallel_region = true;
+  RunTasks();
+  in_parallel_region = false;
+
+  std::exception_ptr error;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    finish_.wait(lock, [this] { return (done_ == count_) && (active_ == 0); });
+    task_ = nullptr;
+    error = error_;
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+void S21ThreadPool::WorkerLoop() {
+  in_parallel_region = true;
+  unsigned long seen = 0;
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    start_.wait(lock, [this, seen] { return stop_ || (generation_ != seen); });
+    if (stop_) {
+      return;
+    }
+
+    seen = generation_;
+    ++active_;
+    lock.unlock();
+    RunTasks();
+    lock.lock();
+    --active_;
+    finish_.notify_all();
+  }
+}
+
+void S21ThreadPool::RunTasks() {
+  while (true) {
+    int index;
+    const std::function<void(int)>* task;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if ((task_ == nullptr) || (next_ >= count_)) {
+        return;
+      }
+      index = next_++;
+      task = task_;
+    }
+
+    try {
+      (*task)(index);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!error_) {
+        error_ = std::current_exception();
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (++done_ == count_) {
+      finish_.notify_all();
+    }
+  }
+}
+
+int s21_get_num_threads() { return s21_get_executor().Concurrency(); }
+
+void s21_set_num_threads(const int threads) {
+  auto new_pool = std::make_unique<S21ThreadPool>(threads);
+  std::lock_guard<std::mutex> lock(pool_mutex);
+  pool.swap(new_pool);
+}
+
+S21Executor& s21_get_executor() {
+  S21Executor* custom = executor.load();
+  return custom != nullptr ? *custom : defaultPool();
+}
+
+void s21_set_executor(S21Executor* custom) noexcept { executor.store(custom); }
+
+void s21_parallel_rows(const int rows, const long row_cost,
+                       const std::function<void(int, int)>& body) {
+  if (rows <= 0) {
+    return;
+  }
+
+  const long work = static_cast<long>(rows) * row_cost;
+  S21Executor& pool_executor = s21_get_executor();
+  const int threads = pool_executor.Concurrency();
+
+  if ((work < kParallelThreshold) || (threads < 2) || (rows < 2)) {
+    body(0, rows);
+    return;
+  }
+
+  const long max_chunks = std::max(1L, work / kParallelThreshold);
+  const int chunks = static_cast<int>(
+      std::min<long>({static_cast<long>(threads) * 4, rows, max_chunks}));
+  const int chunk = (rows + chunks - 1) / chunks;
+  const int count = (rows + chunk - 1) / chunk;
+
+  pool_executor.ParallelFor(count, [&](int index) {
+    const int begin = index * chunk;
+    const int end = std::min(rows, begin + chunk);
+    body(begin, end);
+  });
+}
@@ -0,0 +1,81 @@
+#ifndef S21_MATRIX_PARALLEL_H_
+#define S21_MATRIX_PARALLEL_H_
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Runs task(0) ... task(count - 1), possibly concurrently, and returns
+// once all of them have finished. Implement it to plug in your own pool.
+class S21Executor {
+ public:
+  virtual ~S21Executor() = default;
+
+  virtual int Concurrency() const noexcept = 0;
+  virtual void ParallelFor(const int count,
+                           const std::function<void(int)>& task) = 0;
+
+  // Runs job later, on another thread, and returns at once; used by the
+  // async operations. The default queues it for a set of library-owned
+  // threads kept apart from any pool, so that a job can call ParallelFor.
+  // Those threads are never joined: wait for every pending task before
+  // main returns, since jobs still queued at exit never run. Jobs never
+  // throw. Override it to run async work on your own event loop.
+  virtual void Post(std::function<void()> job);
+};
+
+// Fixed-size pool. The calling thread takes part in the work, so a pool of
+// n threads starts n - 1 workers. Nested calls from a worker run inline.
+class S21ThreadPool : public S21Executor {
+ public:
+  explicit S21ThreadPool(const int threads);
+  S21ThreadPool(const S21ThreadPool&) = delete;
+  S21ThreadPool& operator=(const S21ThreadPool&) = delete;
+  ~S21ThreadPool() override;
+
+  int Concurrency() const noexcept override;
+  void ParallelFor(const int count,
+                   const std::function<void(int)>& task) override;
+
+ private:
+  std::vector<std::thread> workers_;
+  std::mutex submit_mutex_;
+  std::mutex mutex_;
+  std::condition_variable start_;
+  std::condition_variable finish_;
+
+  const std::function<void(int)>* task_;
+  int count_;
+  int next_;
+  int done_;
+  int active_;
+  unsigned long generation_;
+  bool stop_;
+  std::exception_ptr error_;
+
+  void WorkerLoop();
+  void RunTasks();
+};
+
+// Number of threads of the library pool: S21_MATRIX_NUM_THREADS if set,
+// otherwise the hardware concurrency.
+// Resizing replaces the pool, so call it while no operation is running.
+int s21_get_num_threads();
+void s21_set_num_threads(const int threads);
+
+// Executor used by the library. Passing nullptr restores the built-in pool.
+// The caller keeps ownership of a custom executor and must keep it alive
+// while it is installed.
+S21Executor& s21_get_executor();
+void s21_set_executor(S21Executor* executor) noexcept;
+
+// Splits [0, rows) into contiguous ranges and runs body(begin, end) on the
+// library executor. Runs inline when rows * row_cost is below the
+// parallel threshold.
+void s21_parallel_rows(const int rows, const long row_cost,
+                       const std::function<void(int, int)>& body);
+
+#endif  // S21_MATRIX_PARALLEL_H_
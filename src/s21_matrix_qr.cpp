@@ -0,0 +1,403 @@
+#include "s21_matrix_qr.h"
+
+#include <algorithm>
+
+#include "s21_matrix_gemm.h"
+#include "s21_matrix_solve.h"
+
+namespace {
+
+// Panels this narrow are factored one reflector at a time.
+constexpr int kLeaf = 8;
+
+// Rows of an operand transposed per product in gemmTN.
+constexpr int kRowChunk = 256;
+
+template <typename T>
+struct Scratch {
+  std::vector<T> w;
+  std::vector<T> buffer;
+};
+
+// Element (i, c) of a reflector block stored below the diagonal of v.
+template <typename T>
+T reflector(const T* v, const int ldv, const int i, const int c) noexcept {
+  return i > c ? v[i * ldv + c] : (i == c ? T(1) : T(0));
+}
+
+// C += A^T * B for a rows x p matrix A and a rows x q matrix B; C is p x q
+// with stride q. Chunks of A are transposed into buffer so that every
+// product runs on s21_gemm.
+template <typename T>
+void gemmTN(const int rows, const int p, const int q, const T* a,
+            const int lda, const T* b, const int ldb, T* c,
+            std::vector<T>& buffer) {
+  buffer.resize(static_cast<std::size_t>(p) * kRowChunk);
+  for (int r0 = 0; r0 < rows; r0 += kRowChunk) {
+    const int len = std::min(kRowChunk, rows - r0);
+    for (int r = 0; r < len; ++r) {
+      const T* a_r = a + (r0 + r) * lda;
+      for (int k = 0; k < p; ++k) {
+        buffer[k * len + r] = a_r[k];
+      }
+    }
+    s21_gemm(p, q, len, buffer.data(), len, b + r0 * ldb, ldb, c, q);
+  }
+}
+
+// W = V^T * B for a rows x p reflector block V and a rows x q matrix B.
+template <typename T>
+void multiplyVT(const T* v, const int ldv, const int rows, const int p,
+                const T* b, const int ldb, const int q, T* w,
+                std::vector<T>& buffer) {
+  std::fill(w, w + p * q, T(0));
+
+  // The unit lower triangle on top, then plain rows.
+  const int top = std::min(p, rows);
+  for (int i = 0; i < top; ++i) {
+    const T* b_i = b + i * ldb;
+    for (int c = 0; c <= i; ++c) {
+      const T v_ic = reflector(v, ldv, i, c);
+      T* w_c = w + c * q;
+      for (int j = 0; j < q; ++j) {
+        w_c[j] += v_ic * b_i[j];
+      }
+    }
+  }
+
+  if (rows > p) {
+    gemmTN(rows - p, p, q, v + p * ldv, ldv, b + p * ldb, ldb, w, buffer);
+  }
+}
+
+// B += V * W for the same V and a p x q matrix W.
+template <typename T>
+void multiplyV(const T* v, const int ldv, const int rows, const int p,
+               const T* w, const int q, T* b, const int ldb) {
+  const int top = std::min(p, rows);
+  for (int i = 0; i < top; ++i) {
+    T* b_i = b + i * ldb;
+    for (int c = 0; c <= i; ++c) {
+      const T v_ic = reflector(v, ldv, i, c);
+      const T* w_c = w + c * q;
+      for (int j = 0; j < q; ++j) {
+        b_i[j] += v_ic * w_c[j];
+      }
+    }
+  }
+
+  if (rows > p) {
+    s21_gemm(rows - p, q, p, v + p * ldv, ldv, w, q, b + p * ldb, ldb);
+  }
+}
+
+// W = -T^T * W, or W = -T * W, for an upper triangular p x p factor T.
+template <typename T>
+void multiplyT(const T* t, const int ldt, const int p, T* w, const int q,
+               const bool transpose) {
+  for (int step = 0; step < p; ++step) {
+    // Rows are overwritten in the order that keeps their inputs intact.
+    const int r = transpose ? p - 1 - step : step;
+    T* w_r = w + r * q;
+    const T t_rr = -t[r * ldt + r];
+    for (int j = 0; j < q; ++j) {
+      w_r[j] *= t_rr;
+    }
+    const int begin = transpose ? 0 : r + 1;
+    const int end = transpose ? r : p;
+    for (int c = begin; c < end; ++c) {
+      const T t_rc = transpose ? -t[c * ldt + r] : -t[r * ldt + c];
+      const T* w_c = w + c * q;
+      for (int j = 0; j < q; ++j) {
+        w_r[j] += t_rc * w_c[j];
+      }
+    }
+  }
+}
+
+// B = (I - V * T * V^T) * B, with T^T instead of T if transpose is set.
+template <typename T>
+void applyBlock(const T* v, const int ldv, const int rows, const int p,
+                const T* t, const int ldt, T* b, const int ldb, const int q,
+                const bool transpose, Scratch<T>& scratch) {
+  scratch.w.resize(static_cast<std::size_t>(p) * q);
+  multiplyVT(v, ldv, rows, p, b, ldb, q, scratch.w.data(), scratch.buffer);
+  multiplyT(t, ldt, p, scratch.w.data(), q, transpose);
+  multiplyV(v, ldv, rows, p, scratch.w.data(), q, b, ldb);
+}
+
+// Triangular factor of a block of p reflectors: T(i, i) = tau_i and
+// T(0:i, i) = -tau_i * T(0:i, 0:i) * V(:, 0:i)^T * v_i.
+template <typename T>
+void formT(const T* v, const int ldv, const int rows, const int p,
+           const T* tau, T* t, const int ldt, Scratch<T>& scratch) {
+  // Gram matrix V^T * V: the unit triangle on top, then plain rows.
+  std::vector<T> gram(static_cast<std::size_t>(p) * p);
+  for (int i = 0; i < p; ++i) {
+    for (int c = 0; c <= i; ++c) {
+      const T v_ic = reflector(v, ldv, i, c);
+      for (int k = c; k <= i; ++k) {
+        gram[c * p + k] += v_ic * reflector(v, ldv, i, k);
+      }
+    }
+  }
+  if (rows > p) {
+    gemmTN(rows - p, p, p, v + p * ldv, ldv, v + p * ldv, ldv, gram.data(),
+           scratch.buffer);
+  }
+
+  for (int i = 0; i < p; ++i) {
+    for (int r = 0; r < i; ++r) {
+      T sum = 0;
+      for (int c = r; c < i; ++c) {
+        sum += t[r * ldt + c] * gram[c * p + i];
+      }
+      t[r * ldt + i] = -tau[i] * sum;
+    }
+    t[i * ldt + i] = tau[i];
+    for (int r = i + 1; r < p; ++r) {
+      t[r * ldt + i] = 0;
+    }
+  }
+}
+
+// Squared norm of column c below row `first`, and its dot products with
+// the q columns to its right (into d).
+template <typename T>
+T columnSums(const T* a, const int lda, const int rows, const int first,
+             const int c, const int q, T* d) noexcept {
+  T sigma = 0;
+  std::fill(d, d + q, T(0));
+  for (int i = first; i < rows; ++i) {
+    const T* a_i = a + i * lda + c;
+    sigma += a_i[0] * a_i[0];
+    for (int j = 0; j < q; ++j) {
+      d[j] += a_i[0] * a_i[1 + j];
+    }
+  }
+  return sigma;
+}
+
+// Reflector by reflector, one pass over the rows each: v^T * A is known
+// from the dot products d gathered while the previous reflector updated
+// the columns, so the pass only scales v, applies the update and gathers
+// the sums for the next column. w and d are local so that the compiler
+// can keep them in registers across the stores into a.
+template <typename T>
+void householder(T* a, const int lda, const int rows, const int p,
+                 T* tau) noexcept {
+  T w[kLeaf];
+  T d[kLeaf];
+
+  T sigma = columnSums(a, lda, rows, 1, 0, p - 1, d);
+
+  for (int c = 0; c < p; ++c) {
+    T* a_c = a + c * lda;
+    const T alpha = a_c[c];
+    const int q = p - c - 1;
+
+    if (sigma == 0) {
+      tau[c] = 0;
+      if (q > 0) {
+        sigma = columnSums(a, lda, rows, c + 2, c + 1, q - 1, d);
+      }
+      continue;
+    }
+
+    const T beta = -std::copysign(std::sqrt(alpha * alpha + sigma), alpha);
+    const T scale = 1 / (alpha - beta);
+    tau[c] = (beta - alpha) / beta;
+    a_c[c] = beta;
+
+    for (int j = 0; j < q; ++j) {
+      w[j] = tau[c] * (a_c[c + 1 + j] + scale * d[j]);
+      a_c[c + 1 + j] -= w[j];
+    }
+
+    sigma = 0;
+    std::fill(d, d + q, T(0));
+    for (int i = c + 1; i < rows; ++i) {
+      T* a_i = a + i * lda + c;
+      const T v = a_i[0] * scale;
+      a_i[0] = v;
+      for (int j = 0; j < q; ++j) {
+        a_i[1 + j] -= v * w[j];
+      }
+      if ((q > 0) && (i > c + 1)) {
+        sigma += a_i[1] * a_i[1];
+        for (int j = 1; j < q; ++j) {
+          d[j - 1] += a_i[1] * a_i[1 + j];
+        }
+      }
+    }
+  }
+}
+
+// Factors the left half of a panel, applies its block reflector to the
+// right half and factors what remains, so most of the work is in
+// applyBlock's matrix products.
+template <typename T>
+void factorPanel(T* a, const int lda, const int rows, const int p, T* tau,
+                 Scratch<T>& scratch) {
+  if (p <= kLeaf) {
+    householder(a, lda, rows, p, tau);
+    return;
+  }
+
+  const int p1 = p / 2;
+  factorPanel(a, lda, rows, p1, tau, scratch);
+
+  std::vector<T> t(static_cast<std::size_t>(p1) * p1);
+  formT(a, lda, rows, p1, tau, t.data(), p1, scratch);
+  applyBlock(a, lda, rows, p1, t.data(), p1, a + p1, lda, p - p1, true,
+             scratch);
+
+  factorPanel(a + p1 * lda + p1, lda, rows - p1, p - p1, tau + p1, scratch);
+}
+
+}  // namespace
+
+template <typename T>
+S21BasicQR<T>::S21BasicQR(const S21BasicMatrix<T>& matrix)
+    : qr_(matrix), tau_(), factors_() {
+  const int m = qr_.getRows();
+  const int n = qr_.getCols();
+
+  if (m < n) {
+    throw std::domain_error("S21QR: matrix must have at least as many rows "
+                            "as cols");
+  }
+
+  const int ld = qr_.getStride();
+  const int panels = (n + S21_QR_BLOCK - 1) / S21_QR_BLOCK;
+  tau_.assign(n, 0);
+  factors_.assign(static_cast<std::size_t>(panels) * S21_QR_BLOCK *
+                      S21_QR_BLOCK,
+                  0);
+  Scratch<T> scratch;
+
+  for (int j = 0; j < n; j += S21_QR_BLOCK) {
+    const int p = std::min(S21_QR_BLOCK, n - j);
+    T* panel = qr_.data() + j * ld + j;
+    T* t = factors_.data() + j * S21_QR_BLOCK;
+
+    factorPanel(panel, ld, m - j, p, tau_.data() + j, scratch);
+    formT(panel, ld, m - j, p, tau_.data() + j, t, S21_QR_BLOCK, scratch);
+
+    if (j + p < n) {
+      applyBlock(panel, ld, m - j, p, t, S21_QR_BLOCK, panel + p, ld,
+                 n - j - p, true, scratch);
+    }
+  }
+}
+
+template <typename T>
+int S21BasicQR<T>::getRows() const noexcept {
+  return qr_.getRows();
+}
+
+template <typename T>
+int S21BasicQR<T>::getCols() const noexcept {
+  return qr_.getCols();
+}
+
+template <typename T>
+const S21BasicMatrix<T>& S21BasicQR<T>::getQR() const noexcept {
+  return qr_;
+}
+
+template <typename T>
+const std::vector<T>& S21BasicQR<T>::getTau() const noexcept {
+  return tau_;
+}
+
+// Column i of R has the norm of column i of A, so r_ii is measured against
+// the rest of its column and scaling a column of A changes nothing.
+template <typename T>
+bool S21BasicQR<T>::IsRankDeficient() const noexcept {
+  for (int i = 0; i < qr_.getCols(); ++i) {
+    T scale = 0;
+    for (int k = 0; k <= i; ++k) {
+      scale = std::max(scale, std::abs(qr_.at_unchecked(k, i)));
+    }
+    if (std::abs(qr_.at_unchecked(i, i)) <= S21Tolerance<T>::kEps * scale) {
+      return true;
+    }
+  }
+  return false;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicQR<T>::R() const {
+  const int n = qr_.getCols();
+  S21BasicMatrix<T> r(n, n);
+
+  for (int i = 0; i < n; ++i) {
+    std::copy(qr_.row(i) + i, qr_.row(i) + n, r.row(i) + i);
+  }
+
+  return r;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicQR<T>::Q() const {
+  S21BasicMatrix<T> q(qr_.getRows(), qr_.getCols());
+
+  for (int i = 0; i < qr_.getCols(); ++i) {
+    q.at_unchecked(i, i) = 1;
+  }
+  applyBlocks(q, false);
+
+  return q;
+}
+
+template <typename T>
+void S21BasicQR<T>::ApplyQT(S21BasicMatrix<T>& b) const {
+  if (b.getRows() != qr_.getRows()) {
+    throw std::invalid_argument("S21QR: different dimensions");
+  }
+
+  applyBlocks(b, true);
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicQR<T>::Solve(const S21BasicMatrix<T>& b) const {
+  if (b.getRows() != qr_.getRows()) {
+    throw std::invalid_argument("S21QR: different dimensions");
+  }
+
+  if (IsRankDeficient()) {
+    throw std::domain_error("S21QR: matrix is rank deficient");
+  }
+
+  // R * X = (Q^T * B)(0:n, :); the remaining rows hold the residual.
+  S21BasicMatrix<T> x(b);
+  applyBlocks(x, true);
+  x.setRows(qr_.getCols());
+  s21_solve_triangular(R(), x, false);
+
+  return x;
+}
+
+// Q^T * B applies the block reflectors first to last, Q * B last to first.
+template <typename T>
+void S21BasicQR<T>::applyBlocks(S21BasicMatrix<T>& b,
+                                const bool transpose) const {
+  const int m = qr_.getRows();
+  const int n = qr_.getCols();
+  const int ld = qr_.getStride();
+  const int panels = (n + S21_QR_BLOCK - 1) / S21_QR_BLOCK;
+  Scratch<T> scratch;
+
+  for (int step = 0; step < panels; ++step) {
+    const int j = (transpose ? step : panels - 1 - step) * S21_QR_BLOCK;
+    const int p = std::min(S21_QR_BLOCK, n - j);
+    applyBlock(qr_.data() + j * ld + j, ld, m - j, p,
+               factors_.data() + j * S21_QR_BLOCK, S21_QR_BLOCK, b.row(j),
+               b.getStride(), b.getCols(), transpose, scratch);
+  }
+}
+
+template class S21BasicQR<float>;
+template class S21BasicQR<double>;
+template class S21BasicQR<long double>;
@@ -0,0 +1,58 @@
+#ifndef S21_MATRIX_QR_H_
+#define S21_MATRIX_QR_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Columns per block reflector. Each block of Householder reflectors is kept
+// in compact WY form, H_1 * ... * H_nb = I - V * T * V^T, so applying it to
+// the trailing columns (or to a right-hand side) is three matrix products
+// on the s21_gemm path instead of nb rank-one updates.
+#define S21_QR_BLOCK 64
+
+// Householder QR factorization of an m x n matrix with m >= n: A = Q * R,
+// Q orthogonal and R upper triangular. The reflectors (unit diagonal, not
+// stored) are packed below the diagonal and R on and above it.
+//
+// Panels are factored recursively (halving the columns down to a few),
+// so even a tall, skinny matrix like 1,000,000 x 64 is processed mostly by
+// matrix products streaming over its rows.
+template <typename T>
+class S21BasicQR {
+ public:
+  explicit S21BasicQR(const S21BasicMatrix<T>& matrix);
+
+  // Accessors
+  int getRows() const noexcept;
+  int getCols() const noexcept;
+  const S21BasicMatrix<T>& getQR() const noexcept;
+  const std::vector<T>& getTau() const noexcept;
+
+  // Functions
+  bool IsRankDeficient() const noexcept;
+  // The n x n factor R.
+  S21BasicMatrix<T> R() const;
+  // The first n columns of Q, an m x n matrix with orthonormal columns.
+  S21BasicMatrix<T> Q() const;
+  // Overwrites the m-row matrix B with Q^T * B.
+  void ApplyQT(S21BasicMatrix<T>& b) const;
+  // X minimizing ||A * X - B|| column by column, n x k for an m x k B.
+  S21BasicMatrix<T> Solve(const S21BasicMatrix<T>& b) const;
+
+ private:
+  S21BasicMatrix<T> qr_;
+  std::vector<T> tau_;
+  // Triangular factors of the block reflectors, S21_QR_BLOCK^2 each.
+  std::vector<T> factors_;
+
+  void applyBlocks(S21BasicMatrix<T>& b, const bool transpose) const;
+};
+
+using S21QR = S21BasicQR<double>;
+
+extern template class S21BasicQR<float>;
+extern template class S21BasicQR<double>;
+extern template class S21BasicQR<long double>;
+
+#endif  // S21_MATRIX_QR_H_
@@ -0,0 +1,486 @@
+#include "s21_matrix_simd.h"
+
+#include <cmath>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define S21_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+void addScalar(double* dst, const double* src, const int rows, const int cols,
+               const int dst_stride, const int src_stride) {
+  for (int i = 0; i < rows; ++i, dst += dst_stride, src += src_stride) {
+    for (int j = 0; j < cols; ++j) {
+      dst[j] += src[j];
+    }
+  }
+}
+
+void subScalar(double* dst, const double* src, const int rows, const int cols,
+               const int dst_stride, const int src_stride) {
+  for (int i = 0; i < rows; ++i, dst += dst_stride, src += src_stride) {
+    for (int j = 0; j < cols; ++j) {
+      dst[j] -= src[j];
+    }
+  }
+}
+
+void scaleScalar(double* dst, const double num, const int rows,
+                 const int cols, const int dst_stride) {
+  for (int i = 0; i < rows; ++i, dst += dst_stride) {
+    for (int j = 0; j < cols; ++j) {
+      dst[j] *= num;
+    }
+  }
+}
+
+bool equalScalar(const double* a, const double* b, const int rows,
+                 const int cols, const int a_stride, const int b_stride,
+                 const double eps) {
+  for (int i = 0; i < rows; ++i, a += a_stride, b += b_stride) {
+    for (int j = 0; j < cols; ++j) {
+      if (fabs(a[j] - b[j]) > eps) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Elements outside the top-left full_rows x full_cols part, which the
+// tiled kernels leave to this scalar loop.
+void transposeEdges(double* dst, const double* src, const int rows,
+                    const int cols, const int dst_stride, const int src_stride,
+                    const int full_rows, const int full_cols) {
+  for (int i = 0; i < rows; ++i) {
+    for (int j = i < full_rows ? full_cols : 0; j < cols; ++j) {
+      dst[j * dst_stride + i] = src[i * src_stride + j];
+    }
+  }
+}
+
+void transposeScalar(double* dst, const double* src, const int rows,
+                     const int cols, const int dst_stride,
+                     const int src_stride) {
+  transposeEdges(dst, src, rows, cols, dst_stride, src_stride, 0, 0);
+}
+
+const S21SimdKernels kScalarKernels = {"scalar",    addScalar,
+                                       subScalar,   scaleScalar,
+                                       equalScalar, transposeScalar};
+
+#ifdef S21_SIMD_X86
+
+// The vector loops below share one shape: full vectors first, then a scalar
+// tail for the last cols % width elements of each row.
+
+__attribute__((target("sse2"))) void addSSE2(double* dst, const double* src,
+                                             const int rows, const int cols,
+                                             const int dst_stride,
+                                             const int src_stride) {
+  for (int i = 0; i < rows; ++i, dst += dst_stride, src += src_stride) {
+    int j = 0;
+    for (; j + 2 <= cols; j += 2) {
+      _mm_storeu_pd(dst + j,
+                    _mm_add_pd(_mm_loadu_pd(dst + j), _mm_loadu_pd(src + j)));
+    }
+    for (; j < cols; ++j) {
+      dst[j] += src[j];
+    }
+  }
+}
+
+__attribute__((target("sse2"))) void subSSE2(double* dst, const double* src,
+                                             const int rows, const int cols,
+                                             const int dst_stride,
+                                             const int src_stride) {
+  for (int i = 0; i < rows; ++i, dst += dst_stride, src += src_stride) {
+    int j = 0;
+    for (; j + 2 <= cols; j += 2) {
+      _mm_storeu_pd(dst + j,
+                    _mm_sub_pd(_mm_loadu_pd(dst + j), _mm_loadu_pd(src + j)));
+    }
+    for (; j < cols; ++j) {
+      dst[j] -= src[j];
+    }
+  }
+}
+
+__attribute__((target("sse2"))) void scaleSSE2(double* dst, const double num,
+                                               const int rows, const int cols,
+                                               const int dst_stride) {
+  const __m128d factor = _mm_set1_pd(num);
+  for (int i = 0; i < rows; ++i, dst += dst_stride) {
+    int j = 0;
+    for (; j + 2 <= cols; j += 2) {
+      _mm_storeu_pd(dst + j, _mm_mul_pd(_mm_loadu_pd(dst + j), factor));
+    }
+    for (; j < cols; ++j) {
+      dst[j] *= num;
+    }
+  }
+}
+
+__attribute__((target("sse2"))) bool equalSSE2(const double* a,
+                                               const double* b,
+                                               const int rows, const int cols,
+                                               const int a_stride,
+                                               const int b_stride,
+                                               const double eps) {
+  const __m128d sign = _mm_set1_pd(-0.0);
+  const __m128d limit = _mm_set1_pd(eps);
+  for (int i = 0; i < rows; ++i, a += a_stride, b += b_stride) {
+    int j = 0;
+    for (; j + 2 <= cols; j += 2) {
+      __m128d diff = _mm_sub_pd(_mm_loadu_pd(a + j), _mm_loadu_pd(b + j));
+      diff = _mm_andnot_pd(sign, diff);
+      if (_mm_movemask_pd(_mm_cmpgt_pd(diff, limit))) {
+        return false;
+      }
+    }
+    for (; j < cols; ++j) {
+      if (fabs(a[j] - b[j]) > eps) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+__attribute__((target("sse2"))) void transposeSSE2(double* dst,
+                                                   const double* src,
+                                                   const int rows,
+                                                   const int cols,
+                                                   const int dst_stride,
+                                                   const int src_stride) {
+  const int full_rows = rows / 2 * 2;
+  const int full_cols = cols / 2 * 2;
+  for (int i = 0; i < full_rows; i += 2) {
+    const double* s = src + i * src_stride;
+    for (int j = 0; j < full_cols; j += 2) {
+      const __m128d r0 = _mm_loadu_pd(s + j);
+      const __m128d r1 = _mm_loadu_pd(s + src_stride + j);
+      _mm_storeu_pd(dst + j * dst_stride + i, _mm_unpacklo_pd(r0, r1));
+      _mm_storeu_pd(dst + (j + 1) * dst_stride + i, _mm_unpackhi_pd(r0, r1));
+    }
+  }
+  transposeEdges(dst, src, rows, cols, dst_stride, src_stride, full_rows,
+                 full_cols);
+}
+
+__attribute__((target("avx2"))) void addAVX2(double* dst, const double* src,
+                                             const int rows, const int cols,
+                                             const int dst_stride,
+                                             const int src_stride) {
+  for (int i = 0; i < rows; ++i, dst += dst_stride, src += src_stride) {
+    int j = 0;
+    for (; j + 4 <= cols; j += 4) {
+      _mm256_storeu_pd(dst + j, _mm256_add_pd(_mm256_loadu_pd(dst + j),
+                                              _mm256_loadu_pd(src + j)));
+    }
+    for (; j < cols; ++j) {
+      dst[j] += src[j];
+    }
+  }
+}
+
+__attribute__((target("avx2"))) void subAVX2(double* dst, const double* src,
+                                             const int rows, const int cols,
+                                             const int dst_stride,
+                                             const int src_stride) {
+  for (int i = 0; i < rows; ++i, dst += dst_stride, src += src_stride) {
+    int j = 0;
+    for (; j + 4 <= cols; j += 4) {
+      _mm256_storeu_pd(dst + j, _mm256_sub_pd(_mm256_loadu_pd(dst + j),
+                                              _mm256_loadu_pd(src + j)));
+    }
+    for (; j < cols; ++j) {
+      dst[j] -= src[j];
+    }
+  }
+}
+
+__attribute__((target("avx2"))) void scaleAVX2(double* dst, const double num,
+                                               const int rows, const int cols,
+                                               const int dst_stride) {
+  const __m256d factor = _mm256_set1_pd(num);
+  for (int i = 0; i < rows; ++i, dst += dst_stride) {
+    int j = 0;
+    for (; j + 4 <= cols; j += 4) {
+      _mm256_storeu_pd(dst + j,
+                       _mm256_mul_pd(_mm256_loadu_pd(dst + j), factor));
+    }
+    for (; j < cols; ++j) {
+      dst[j] *= num;
+    }
+  }
+}
+
+__attribute__((target("avx2"))) bool equalAVX2(const double* a,
+                                               const double* b,
+                                               const int rows, const int cols,
+                                               const int a_stride,
+                                               const int b_stride,
+                                               const double eps) {
+  const __m256d sign = _mm256_set1_pd(-0.0);
+  const __m256d limit = _mm256_set1_pd(eps);
+  for (int i = 0; i < rows; ++i, a += a_stride, b += b_stride) {
+    int j = 0;
+    for (; j + 4 <= cols; j += 4) {
+      __m256d diff =
+          _mm256_sub_pd(_mm256_loadu_pd(a + j), _mm256_loadu_pd(b + j));
+      diff = _mm256_andnot_pd(sign, diff);
+      if (_mm256_movemask_pd(_mm256_cmp_pd(diff, limit, _CMP_GT_OQ))) {
+        return false;
+      }
+    }
+    for (; j < cols; ++j) {
+      if (fabs(a[j] - b[j]) > eps) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Pairs of rows are interleaved, then 128-bit lanes are exchanged between
+// the pairs.
+__attribute__((target("avx2"))) void transposeAVX2(double* dst,
+                                                   const double* src,
+                                                   const int rows,
+                                                   const int cols,
+                                                   const int dst_stride,
+                                                   const int src_stride) {
+  const int full_rows = rows / 4 * 4;
+  const int full_cols = cols / 4 * 4;
+  for (int i = 0; i < full_rows; i += 4) {
+    const double* s = src + i * src_stride;
+    for (int j = 0; j < full_cols; j += 4) {
+      const __m256d r0 = _mm256_loadu_pd(s + j);
+      const __m256d r1 = _mm256_loadu_pd(s + src_stride + j);
+      const __m256d r2 = _mm256_loadu_pd(s + 2 * src_stride + j);
+      const __m256d r3 = _mm256_loadu_pd(s + 3 * src_stride + j);
+      const __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+      const __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+      const __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+      const __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+      double* d = dst + j * dst_stride + i;
+      _mm256_storeu_pd(d, _mm256_permute2f128_pd(t0, t2, 0x20));
+      _mm256_storeu_pd(d + dst_stride, _mm256_permute2f128_pd(t1, t3, 0x20));
+      _mm256_storeu_pd(d + 2 * dst_stride,
+                       _mm256_permute2f128_pd(t0, t2, 0x31));
+      _mm256_storeu_pd(d + 3 * dst_stride,
+                       _mm256_permute2f128_pd(t1, t3, 0x31));
+    }
+  }
+  transposeEdges(dst, src, rows, cols, dst_stride, src_stride, full_rows,
+                 full_cols);
+}
+
+__attribute__((target("avx512f"))) void addAVX512(double* dst,
+                                                  const double* src,
+                                                  const int rows,
+                                                  const int cols,
+                                                  const int dst_stride,
+                                                  const int src_stride) {
+  for (int i = 0; i < rows; ++i, dst += dst_stride, src += src_stride) {
+    int j = 0;
+    for (; j + 8 <= cols; j += 8) {
+      _mm512_storeu_pd(dst + j, _mm512_add_pd(_mm512_loadu_pd(dst + j),
+                                              _mm512_loadu_pd(src + j)));
+    }
+    if (j < cols) {
+      const __mmask8 mask = static_cast<__mmask8>((1u << (cols - j)) - 1);
+      _mm512_mask_storeu_pd(
+          dst + j, mask,
+          _mm512_add_pd(_mm512_maskz_loadu_pd(mask, dst + j),
+                        _mm512_maskz_loadu_pd(mask, src + j)));
+    }
+  }
+}
+
+__attribute__((target("avx512f"))) void subAVX512(double* dst,
+                                                  const double* src,
+                                                  const int rows,
+                                                  const int cols,
+                                                  const int dst_stride,
+                                                  const int src_stride) {
+  for (int i = 0; i < rows; ++i, dst += dst_stride, src += src_stride) {
+    int j = 0;
+    for (; j + 8 <= cols; j += 8) {
+      _mm512_storeu_pd(dst + j, _mm512_sub_pd(_mm512_loadu_pd(dst + j),
+                                              _mm512_loadu_pd(src + j)));
+    }
+    if (j < cols) {
+      const __mmask8 mask = static_cast<__mmask8>((1u << (cols - j)) - 1);
+      _mm512_mask_storeu_pd(
+          dst + j, mask,
+          _mm512_sub_pd(_mm512_maskz_loadu_pd(mask, dst + j),
+                        _mm512_maskz_loadu_pd(mask, src + j)));
+    }
+  }
+}
+
+__attribute__((target("avx512f"))) void scaleAVX512(double* dst,
+                                                    const double num,
+                                                    const int rows,
+                                                    const int cols,
+                                                    const int dst_stride) {
+  const __m512d factor = _mm512_set1_pd(num);
+  for (int i = 0; i < rows; ++i, dst += dst_stride) {
+    int j = 0;
+    for (; j + 8 <= cols; j += 8) {
+      _mm512_storeu_pd(dst + j,
+                       _mm512_mul_pd(_mm512_loadu_pd(dst + j), factor));
+    }
+    if (j < cols) {
+      const __mmask8 mask = static_cast<__mmask8>((1u << (cols - j)) - 1);
+      _mm512_mask_storeu_pd(
+          dst + j, mask,
+          _mm512_mul_pd(_mm512_maskz_loadu_pd(mask, dst + j), factor));
+    }
+  }
+}
+
+__attribute__((target("avx512f"))) bool equalAVX512(
+    const double* a, const double* b, const int rows, const int cols,
+    const int a_stride, const int b_stride, const double eps) {
+  const __m512d limit = _mm512_set1_pd(eps);
+  for (int i = 0; i < rows; ++i, a += a_stride, b += b_stride) {
+    int j = 0;
+    for (; j + 8 <= cols; j += 8) {
+      __m512d diff = _mm512_abs_pd(
+          _mm512_sub_pd(_mm512_loadu_pd(a + j), _mm512_loadu_pd(b + j)));
+      if (_mm512_cmp_pd_mask(diff, limit, _CMP_GT_OQ)) {
+        return false;
+      }
+    }
+    if (j < cols) {
+      const __mmask8 mask = static_cast<__mmask8>((1u << (cols - j)) - 1);
+      __m512d diff =
+          _mm512_abs_pd(_mm512_sub_pd(_mm512_maskz_loadu_pd(mask, a + j),
+                                      _mm512_maskz_loadu_pd(mask, b + j)));
+      if (_mm512_mask_cmp_pd_mask(mask, diff, limit, _CMP_GT_OQ)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Full-mask forms of the shuffles: the plain intrinsics pass an undefined
+// vector through, which GCC reports as maybe-uninitialized.
+__attribute__((target("avx512f"))) inline __m512d unpackLo512(__m512d a,
+                                                             __m512d b) {
+  return _mm512_mask_unpacklo_pd(a, 0xFF, a, b);
+}
+
+__attribute__((target("avx512f"))) inline __m512d unpackHi512(__m512d a,
+                                                             __m512d b) {
+  return _mm512_mask_unpackhi_pd(a, 0xFF, a, b);
+}
+
+template <int kImm>
+__attribute__((target("avx512f"))) inline __m512d shuffleLanes512(
+    __m512d a, __m512d b) {
+  return _mm512_mask_shuffle_f64x2(a, 0xFF, a, b, kImm);
+}
+
+// Rows are interleaved in pairs, then two rounds of 128-bit lane shuffles
+// (even lanes with 0x88, odd lanes with 0xDD) gather each column.
+__attribute__((target("avx512f"))) void transposeAVX512(double* dst,
+                                                        const double* src,
+                                                        const int rows,
+                                                        const int cols,
+                                                        const int dst_stride,
+                                                        const int src_stride) {
+  const int full_rows = rows / 8 * 8;
+  const int full_cols = cols / 8 * 8;
+  for (int i = 0; i < full_rows; i += 8) {
+    const double* s = src + i * src_stride;
+    for (int j = 0; j < full_cols; j += 8) {
+      __m512d r[8];
+      for (int k = 0; k < 8; ++k) {
+        r[k] = _mm512_loadu_pd(s + k * src_stride + j);
+      }
+
+      __m512d t[8];
+      for (int k = 0; k < 8; k += 2) {
+        t[k] = unpackLo512(r[k], r[k + 1]);
+        t[k + 1] = unpackHi512(r[k], r[k + 1]);
+      }
+
+      // u[0..3] hold columns {0, 4}, {2, 6}, {1, 5}, {3, 7} of rows 0-3,
+      // u[4..7] the same columns of rows 4-7.
+      __m512d u[8];
+      for (int k = 0; k < 8; k += 4) {
+        u[k] = shuffleLanes512<0x88>(t[k], t[k + 2]);
+        u[k + 1] = shuffleLanes512<0xDD>(t[k], t[k + 2]);
+        u[k + 2] = shuffleLanes512<0x88>(t[k + 1], t[k + 3]);
+        u[k + 3] = shuffleLanes512<0xDD>(t[k + 1], t[k + 3]);
+      }
+
+      static const int kFirstColumn[4] = {0, 2, 1, 3};
+      double* d = dst + j * dst_stride + i;
+      for (int k = 0; k < 4; ++k) {
+        const int col = kFirstColumn[k];
+        _mm512_storeu_pd(d + col * dst_stride,
+                         shuffleLanes512<0x88>(u[k], u[k + 4]));
+        _mm512_storeu_pd(d + (col + 4) * dst_stride,
+                         shuffleLanes512<0xDD>(u[k], u[k + 4]));
+      }
+    }
+  }
+  transposeEdges(dst, src, rows, cols, dst_stride, src_stride, full_rows,
+                 full_cols);
+}
+
+const S21SimdKernels kSSE2Kernels = {"sse2",    addSSE2,   subSSE2,
+                                     scaleSSE2, equalSSE2, transposeSSE2};
+const S21SimdKernels kAVX2Kernels = {"avx2",    addAVX2,   subAVX2,
+                                     scaleAVX2, equalAVX2, transposeAVX2};
+const S21SimdKernels kAVX512Kernels = {"avx512",    addAVX512,
+                                       subAVX512,   scaleAVX512,
+                                       equalAVX512, transposeAVX512};
+
+#endif  // S21_SIMD_X86
+
+const S21SimdKernels& selectKernels() noexcept {
+  const S21SimdKernels* kernels = s21_simd_kernels(S21SimdLevel::kAVX512);
+  if (kernels == nullptr) {
+    kernels = s21_simd_kernels(S21SimdLevel::kAVX2);
+  }
+  if (kernels == nullptr) {
+    kernels = s21_simd_kernels(S21SimdLevel::kSSE2);
+  }
+  if (kernels == nullptr) {
+    kernels = &kScalarKernels;
+  }
+  return *kernels;
+}
+
+}  // namespace
+
+const S21SimdKernels* s21_simd_kernels(const S21SimdLevel level) noexcept {
+  switch (level) {
+    case S21SimdLevel::kScalar:
+      return &kScalarKernels;
+#ifdef S21_SIMD_X86
+    case S21SimdLevel::kSSE2:
+      return __builtin_cpu_supports("sse2") ? &kSSE2Kernels : nullptr;
+    case S21SimdLevel::kAVX2:
+      return __builtin_cpu_supports("avx2") ? &kAVX2Kernels : nullptr;
+    case S21SimdLevel::kAVX512:
+      return __builtin_cpu_supports("avx512f") ? &kAVX512Kernels : nullptr;
+#endif
+    default:
+      return nullptr;
+  }
+}
+
+const S21SimdKernels& s21_simd_kernels() noexcept {
+  static const S21SimdKernels& kernels = selectKernels();
+  return kernels;
+}
@@ -0,0 +1,33 @@
+#ifndef S21_MATRIX_SIMD_H_
+#define S21_MATRIX_SIMD_H_
+
+// Element-wise kernels over row-major blocks of rows x cols elements.
+// Strides are given in elements; row padding is never touched.
+struct S21SimdKernels {
+  const char* name;
+  void (*add)(double* dst, const double* src, const int rows, const int cols,
+              const int dst_stride, const int src_stride);
+  void (*sub)(double* dst, const double* src, const int rows, const int cols,
+              const int dst_stride, const int src_stride);
+  void (*scale)(double* dst, const double num, const int rows, const int cols,
+                const int dst_stride);
+  bool (*equal)(const double* a, const double* b, const int rows,
+                const int cols, const int a_stride, const int b_stride,
+                const double eps);
+  // dst (cols x rows) = src (rows x cols)^T, in register tiles of
+  // 2x2 (SSE2), 4x4 (AVX2) or 8x8 (AVX-512). Meant for blocks that fit in
+  // L1; larger matrices are split by the caller.
+  void (*transpose)(double* dst, const double* src, const int rows,
+                    const int cols, const int dst_stride,
+                    const int src_stride);
+};
+
+enum class S21SimdLevel { kScalar, kSSE2, kAVX2, kAVX512 };
+
+// Best kernel set for the running CPU, selected once on first use.
+const S21SimdKernels& s21_simd_kernels() noexcept;
+
+// Kernel set for a given level, or nullptr if the CPU does not support it.
+const S21SimdKernels* s21_simd_kernels(const S21SimdLevel level) noexcept;
+
+#endif  // S21_MATRIX_SIMD_H_
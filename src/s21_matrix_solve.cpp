@@ -0,0 +1,213 @@
+#include "s21_matrix_solve.h"
+
+#include <algorithm>
+
+#include "s21_matrix_cholesky.h"
+#include "s21_matrix_lu.h"
+#include "s21_matrix_qr.h"
+#include "s21_matrix_stats.h"
+
+namespace {
+
+// True if every element on the other side of the diagonal is exactly zero.
+template <typename T>
+bool isTriangular(const S21BasicMatrix<T>& a, const bool lower) noexcept {
+  const int n = a.getRows();
+  for (int i = 0; i < n; ++i) {
+    const T* row = a.row(i);
+    const int begin = lower ? i + 1 : 0;
+    const int end = lower ? n : i;
+    for (int j = begin; j < end; ++j) {
+      if (row[j] != 0) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Necessary for positive definiteness, and cheap enough to try first.
+template <typename T>
+bool isSymmetricPositiveDiagonal(const S21BasicMatrix<T>& a) noexcept {
+  const int n = a.getRows();
+  for (int i = 0; i < n; ++i) {
+    if (!(a.at_unchecked(i, i) > 0)) {
+      return false;
+    }
+    for (int j = i + 1; j < n; ++j) {
+      if (a.at_unchecked(i, j) != a.at_unchecked(j, i)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// True if a_ii is at most kEps times the largest element of column i inside
+// the triangle, the scale-invariant pivot test of S21LU.
+template <typename T>
+bool isNegligibleDiagonal(const S21BasicMatrix<T>& a, const int i,
+                          const bool lower) noexcept {
+  const int begin = lower ? i : 0;
+  const int end = lower ? a.getRows() : i + 1;
+  T scale = 0;
+  for (int k = begin; k < end; ++k) {
+    scale = std::max(scale, std::abs(a.at_unchecked(k, i)));
+  }
+  return std::abs(a.at_unchecked(i, i)) <= S21Tolerance<T>::kEps * scale;
+}
+
+}  // namespace
+
+template <typename T>
+S21BasicMatrix<T> s21_solve(const S21BasicMatrix<T>& a,
+                            const S21BasicMatrix<T>& b,
+                            const S21Structure structure) {
+  const int n = a.getRows();
+
+  if (n != a.getCols()) {
+    throw std::domain_error("Solve: matrix must be squared");
+  }
+
+  if (b.getRows() != n) {
+    throw std::invalid_argument("Solve: different dimensions");
+  }
+
+  S21_STATS_OP(S21Op::kSolve,
+               2.0 / 3 * n * n * n + 2.0 * n * n * b.getCols());
+
+  S21Structure kind = structure;
+  if (kind == S21Structure::kAuto) {
+    if (isTriangular(a, true)) {
+      kind = S21Structure::kLowerTriangular;
+    } else if (isTriangular(a, false)) {
+      kind = S21Structure::kUpperTriangular;
+    } else if (isSymmetricPositiveDiagonal(a)) {
+      kind = S21Structure::kSymmetricPositiveDefinite;
+    }
+  }
+
+  S21BasicMatrix<T> x(b);
+
+  if ((kind == S21Structure::kLowerTriangular) ||
+      (kind == S21Structure::kUpperTriangular)) {
+    s21_solve_triangular(a, x, kind == S21Structure::kLowerTriangular);
+    return x;
+  }
+
+  if (kind == S21Structure::kSymmetricPositiveDefinite) {
+    const S21BasicCholesky<T> cholesky(a);
+    if (cholesky.IsPositiveDefinite()) {
+      cholesky.SolveInPlace(x);
+      return x;
+    }
+    // A guess from the structure scan may still be indefinite.
+    if (structure != S21Structure::kAuto) {
+      throw std::domain_error("Solve: matrix is not positive definite");
+    }
+  }
+
+  const S21BasicLU<T> lu(a);
+  if (lu.IsSingular()) {
+    throw std::domain_error("Solve: matrix is singular");
+  }
+  lu.SolveInPlace(x);
+
+  return x;
+}
+
+template <typename T>
+void s21_solve_triangular(const S21BasicMatrix<T>& a, S21BasicMatrix<T>& b,
+                          const bool lower) {
+  const int n = a.getRows();
+
+  if (n != a.getCols()) {
+    throw std::domain_error("Solve: matrix must be squared");
+  }
+
+  if (b.getRows() != n) {
+    throw std::invalid_argument("Solve: different dimensions");
+  }
+
+  for (int i = 0; i < n; ++i) {
+    if (isNegligibleDiagonal(a, i, lower)) {
+      throw std::domain_error("Solve: matrix is singular");
+    }
+  }
+
+  // Row i of X is row i of B minus the already solved rows, scaled by the
+  // diagonal; each update is a contiguous axpy over the right-hand sides.
+  const int m = b.getCols();
+  for (int step = 0; step < n; ++step) {
+    const int i = lower ? step : n - 1 - step;
+    const T* a_i = a.row(i);
+    T* row_i = b.row(i);
+    const int begin = lower ? 0 : i + 1;
+    const int end = lower ? i : n;
+    for (int k = begin; k < end; ++k) {
+      const T l = a_i[k];
+      if (l == 0) {
+        continue;
+      }
+      const T* row_k = b.row(k);
+      for (int j = 0; j < m; ++j) {
+        row_i[j] -= l * row_k[j];
+      }
+    }
+    const T inv = 1 / a_i[i];
+    for (int j = 0; j < m; ++j) {
+      row_i[j] *= inv;
+    }
+  }
+}
+
+template <typename T>
+S21BasicMatrix<T> s21_least_squares(const S21BasicMatrix<T>& a,
+                                    const S21BasicMatrix<T>& b) {
+  const double m = a.getRows();
+  const double n = a.getCols();
+
+  if (m < n) {
+    throw std::domain_error("LeastSquares: matrix must have at least as "
+                            "many rows as cols");
+  }
+
+  if (b.getRows() != a.getRows()) {
+    throw std::invalid_argument("LeastSquares: different dimensions");
+  }
+
+  S21_STATS_OP(S21Op::kLeastSquares,
+               2 * m * n * n - 2.0 / 3 * n * n * n +
+                   (4 * m * n + n * n) * b.getCols());
+
+  const S21BasicQR<T> qr(a);
+  if (qr.IsRankDeficient()) {
+    throw std::domain_error("LeastSquares: matrix is rank deficient");
+  }
+
+  return qr.Solve(b);
+}
+
+template S21BasicMatrix<float> s21_solve(const S21BasicMatrix<float>&,
+                                         const S21BasicMatrix<float>&,
+                                         const S21Structure);
+template S21BasicMatrix<double> s21_solve(const S21BasicMatrix<double>&,
+                                          const S21BasicMatrix<double>&,
+                                          const S21Structure);
+template S21BasicMatrix<long double> s21_solve(
+    const S21BasicMatrix<long double>&, const S21BasicMatrix<long double>&,
+    const S21Structure);
+
+template void s21_solve_triangular(const S21BasicMatrix<float>&,
+                                   S21BasicMatrix<float>&, const bool);
+template void s21_solve_triangular(const S21BasicMatrix<double>&,
+                                   S21BasicMatrix<double>&, const bool);
+template void s21_solve_triangular(const S21BasicMatrix<long double>&,
+                                   S21BasicMatrix<long double>&, const bool);
+
+template S21BasicMatrix<float> s21_least_squares(const S21BasicMatrix<float>&,
+                                                 const S21BasicMatrix<float>&);
+template S21BasicMatrix<double> s21_least_squares(
+    const S21BasicMatrix<double>&, const S21BasicMatrix<double>&);
+template S21BasicMatrix<long double> s21_least_squares(
+    const S21BasicMatrix<long double>&, const S21BasicMatrix<long double>&);
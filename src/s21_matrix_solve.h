@@ -0,0 +1,44 @@
+#ifndef S21_MATRIX_SOLVE_H_
+#define S21_MATRIX_SOLVE_H_
+
+#include "s21_matrix_oop.h"
+
+// Structure of the coefficient matrix of a linear system, which selects
+// the solver.
+enum class S21Structure {
+  // Detected with an O(n^2) scan: triangular, then symmetric with a
+  // positive diagonal (Cholesky, falling back to LU), else general.
+  kAuto,
+  kGeneral,                    // S21LU
+  kSymmetricPositiveDefinite,  // S21Cholesky
+  kLowerTriangular,            // forward substitution
+  kUpperTriangular             // back substitution
+};
+
+// X with A * X = B, one column of X per column of B, without forming
+// A^-1. Throws std::domain_error for a non-square or singular A (or, with
+// kSymmetricPositiveDefinite, one that is not positive definite) and
+// std::invalid_argument when B has a different number of rows.
+//
+// To solve many systems with the same A, keep an S21LU or S21Cholesky and
+// call its Solve: factoring is O(n^3), each solve O(n^2) per column.
+template <typename T>
+S21BasicMatrix<T> s21_solve(const S21BasicMatrix<T>& a,
+                            const S21BasicMatrix<T>& b,
+                            const S21Structure structure = S21Structure::kAuto);
+
+// Overwrites B with the solution of A * X = B for triangular A; only the
+// lower or upper triangle of A is read. O(n^2) per column of B.
+template <typename T>
+void s21_solve_triangular(const S21BasicMatrix<T>& a, S21BasicMatrix<T>& b,
+                          const bool lower);
+
+// X minimizing ||A * X - B|| column by column for an m x n A with m >= n,
+// through a blocked Householder QR. Throws std::domain_error for a wide or
+// rank-deficient A and std::invalid_argument when B has a different number
+// of rows. Keep an S21QR to fit many right-hand sides against the same A.
+template <typename T>
+S21BasicMatrix<T> s21_least_squares(const S21BasicMatrix<T>& a,
+                                    const S21BasicMatrix<T>& b);
+
+#endif  // S21_MATRIX_SOLVE_H_
@@ -0,0 +1,341 @@
+#include "s21_matrix_sparse.h"
+
+#include <algorithm>
+
+#include "s21_matrix_parallel.h"
+
+// S21SparseMatrix
+
+S21SparseMatrix::S21SparseMatrix() : S21SparseMatrix(1, 1) {}
+
+S21SparseMatrix::S21SparseMatrix(int rows, int cols) {
+  if (rows < 1) {
+    throw std::invalid_argument("Invalid rows argument");
+  }
+
+  if (cols < 1) {
+    throw std::invalid_argument("Invalid cols argument");
+  }
+
+  rows_ = rows;
+  cols_ = cols;
+  row_ptr_.assign(rows_ + 1, 0);
+}
+
+S21SparseMatrix::S21SparseMatrix(const S21Matrix& dense,
+                                 const double threshold)
+    : S21SparseMatrix(dense.rows_, dense.cols_) {
+  for (int i = 0; i < rows_; ++i) {
+    const double* row = dense.matrix_ + i * dense.stride_;
+    for (int j = 0; j < cols_; ++j) {
+      if (fabs(row[j]) > threshold) {
+        col_idx_.push_back(j);
+        values_.push_back(row[j]);
+      }
+    }
+    row_ptr_[i + 1] = static_cast<int>(values_.size());
+  }
+}
+
+int S21SparseMatrix::getRows() const noexcept { return rows_; }
+
+int S21SparseMatrix::getCols() const noexcept { return cols_; }
+
+int S21SparseMatrix::getNonZeros() const noexcept {
+  return static_cast<int>(values_.size());
+}
+
+const std::vector<int>& S21SparseMatrix::getRowPtr() const noexcept {
+  return row_ptr_;
+}
+
+const std::vector<int>& S21SparseMatrix::getColIdx() const noexcept {
+  return col_idx_;
+}
+
+const std::vector<double>& S21SparseMatrix::getValues() const noexcept {
+  return values_;
+}
+
+S21Matrix S21SparseMatrix::ToDense() const {
+  S21Matrix dense(rows_, cols_);
+
+  for (int i = 0; i < rows_; ++i) {
+    double* row = dense.matrix_ + i * dense.stride_;
+    for (int p = row_ptr_[i]; p < row_ptr_[i + 1]; ++p) {
+      row[col_idx_[p]] = values_[p];
+    }
+  }
+
+  return dense;
+}
+
+bool S21SparseMatrix::EqMatrix(const S21SparseMatrix& other) const noexcept {
+  if ((rows_ != other.rows_) || (cols_ != other.cols_)) {
+    return false;
+  }
+
+  // Walk both rows in column order; a column missing on one side is zero.
+  for (int i = 0; i < rows_; ++i) {
+    int p = row_ptr_[i], q = other.row_ptr_[i];
+    const int p_end = row_ptr_[i + 1], q_end = other.row_ptr_[i + 1];
+    while ((p < p_end) || (q < q_end)) {
+      double diff;
+      if ((q == q_end) || ((p < p_end) && (col_idx_[p] < other.col_idx_[q]))) {
+        diff = values_[p++];
+      } else if ((p == p_end) || (other.col_idx_[q] < col_idx_[p])) {
+        diff = other.values_[q++];
+      } else {
+        diff = values_[p++] - other.values_[q++];
+      }
+      if (fabs(diff) > S21Tolerance<double>::kEps) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+void S21SparseMatrix::SumMatrix(const S21SparseMatrix& other) {
+  if ((rows_ != other.rows_) || (cols_ != other.cols_)) {
+    throw std::invalid_argument("SumMatrix: different dimensions");
+  }
+
+  merge(other, 1);
+}
+
+void S21SparseMatrix::SubMatrix(const S21SparseMatrix& other) {
+  if ((rows_ != other.rows_) || (cols_ != other.cols_)) {
+    throw std::invalid_argument("SubMatrix: different dimensions");
+  }
+
+  merge(other, -1);
+}
+
+void S21SparseMatrix::merge(const S21SparseMatrix& other, const double sign) {
+  std::vector<int> row_ptr(rows_ + 1, 0);
+  std::vector<int> col_idx;
+  std::vector<double> values;
+  col_idx.reserve(col_idx_.size() + other.col_idx_.size());
+  values.reserve(values_.size() + other.values_.size());
+
+  for (int i = 0; i < rows_; ++i) {
+    int p = row_ptr_[i], q = other.row_ptr_[i];
+    const int p_end = row_ptr_[i + 1], q_end = other.row_ptr_[i + 1];
+    while ((p < p_end) || (q < q_end)) {
+      int col;
+      double value;
+      if ((q == q_end) || ((p < p_end) && (col_idx_[p] < other.col_idx_[q]))) {
+        col = col_idx_[p];
+        value = values_[p++];
+      } else if ((p == p_end) || (other.col_idx_[q] < col_idx_[p])) {
+        col = other.col_idx_[q];
+        value = sign * other.values_[q++];
+      } else {
+        col = col_idx_[p];
+        value = values_[p++] + sign * other.values_[q++];
+        if (fabs(value) <= S21Tolerance<double>::kEps) {
+          continue;
+        }
+      }
+      col_idx.push_back(col);
+      values.push_back(value);
+    }
+    row_ptr[i + 1] = static_cast<int>(values.size());
+  }
+
+  row_ptr_.swap(row_ptr);
+  col_idx_.swap(col_idx);
+  values_.swap(values);
+}
+
+void S21SparseMatrix::MulNumber(const double num) noexcept {
+  for (double& value : values_) {
+    value *= num;
+  }
+}
+
+S21Matrix S21SparseMatrix::MulMatrix(const S21Matrix& dense) const {
+  if (dense.rows_ != cols_) {
+    throw std::domain_error("MulMatrix: cannot multiply matrices");
+  }
+
+  const int n = dense.cols_;
+  S21Matrix res(rows_, n);
+  const long row_cost =
+      (static_cast<long>(values_.size()) / rows_ + 1) * static_cast<long>(n);
+
+  // Row i of the result is a sum of the dense rows picked by row i's
+  // entries, so the inner loop is a contiguous axpy.
+  s21_parallel_rows(rows_, row_cost, [&](int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+      double* res_row = res.matrix_ + i * res.stride_;
+      for (int p = row_ptr_[i]; p < row_ptr_[i + 1]; ++p) {
+        const double value = values_[p];
+        const double* dense_row = dense.matrix_ + col_idx_[p] * dense.stride_;
+        for (int j = 0; j < n; ++j) {
+          res_row[j] += value * dense_row[j];
+        }
+      }
+    }
+  });
+
+  return res;
+}
+
+std::vector<double> S21SparseMatrix::MulVector(
+    const std::vector<double>& x) const {
+  if (static_cast<int>(x.size()) != cols_) {
+    throw std::domain_error("MulVector: cannot multiply matrix by vector");
+  }
+
+  std::vector<double> y(rows_, 0);
+
+  for (int i = 0; i < rows_; ++i) {
+    double sum = 0;
+    for (int p = row_ptr_[i]; p < row_ptr_[i + 1]; ++p) {
+      sum += values_[p] * x[col_idx_[p]];
+    }
+    y[i] = sum;
+  }
+
+  return y;
+}
+
+S21SparseMatrix S21SparseMatrix::Transpose() const {
+  S21SparseMatrix res(cols_, rows_);
+  res.col_idx_.resize(values_.size());
+  res.values_.resize(values_.size());
+
+  // Counting sort by column; rows are visited in order, so every output row
+  // comes out sorted.
+  for (int col : col_idx_) {
+    ++res.row_ptr_[col + 1];
+  }
+  for (int j = 0; j < cols_; ++j) {
+    res.row_ptr_[j + 1] += res.row_ptr_[j];
+  }
+
+  std::vector<int> next(res.row_ptr_.begin(), res.row_ptr_.end() - 1);
+  for (int i = 0; i < rows_; ++i) {
+    for (int p = row_ptr_[i]; p < row_ptr_[i + 1]; ++p) {
+      const int dst = next[col_idx_[p]]++;
+      res.col_idx_[dst] = i;
+      res.values_[dst] = values_[p];
+    }
+  }
+
+  return res;
+}
+
+S21SparseMatrix S21SparseMatrix::operator+(
+    const S21SparseMatrix& other) const {
+  S21SparseMatrix res(*this);
+  res.SumMatrix(other);
+  return res;
+}
+
+S21SparseMatrix S21SparseMatrix::operator-(
+    const S21SparseMatrix& other) const {
+  S21SparseMatrix res(*this);
+  res.SubMatrix(other);
+  return res;
+}
+
+S21Matrix S21SparseMatrix::operator*(const S21Matrix& dense) const {
+  return MulMatrix(dense);
+}
+
+std::vector<double> S21SparseMatrix::operator*(
+    const std::vector<double>& x) const {
+  return MulVector(x);
+}
+
+S21SparseMatrix S21SparseMatrix::operator*(const double num) const {
+  S21SparseMatrix res(*this);
+  res.MulNumber(num);
+  return res;
+}
+
+bool S21SparseMatrix::operator==(const S21SparseMatrix& other) const
+    noexcept {
+  return EqMatrix(other);
+}
+
+double S21SparseMatrix::operator()(const int i, const int j) const {
+  if ((i < 0) || (i > rows_ - 1)) {
+    throw std::out_of_range("i argument out of range");
+  }
+
+  if ((j < 0) || (j > cols_ - 1)) {
+    throw std::out_of_range("j argument out of range");
+  }
+
+  const auto begin = col_idx_.begin() + row_ptr_[i];
+  const auto end = col_idx_.begin() + row_ptr_[i + 1];
+  const auto it = std::lower_bound(begin, end, j);
+
+  return ((it != end) && (*it == j)) ? values_[it - col_idx_.begin()] : 0;
+}
+
+// S21SparseBuilder
+
+S21SparseBuilder::S21SparseBuilder(int rows, int cols) {
+  if (rows < 1) {
+    throw std::invalid_argument("Invalid rows argument");
+  }
+
+  if (cols < 1) {
+    throw std::invalid_argument("Invalid cols argument");
+  }
+
+  rows_ = rows;
+  cols_ = cols;
+}
+
+void S21SparseBuilder::Add(const int i, const int j, const double value) {
+  if ((i < 0) || (i > rows_ - 1)) {
+    throw std::out_of_range("i argument out of range");
+  }
+
+  if ((j < 0) || (j > cols_ - 1)) {
+    throw std::out_of_range("j argument out of range");
+  }
+
+  entries_.push_back({i, j, value});
+}
+
+void S21SparseBuilder::Reserve(const int count) { entries_.reserve(count); }
+
+S21SparseMatrix S21SparseBuilder::Build(const double threshold) const {
+  std::vector<Entry> entries(entries_);
+  std::sort(entries.begin(), entries.end(),
+            [](const Entry& a, const Entry& b) {
+              return (a.row < b.row) || ((a.row == b.row) && (a.col < b.col));
+            });
+
+  S21SparseMatrix res(rows_, cols_);
+
+  for (std::size_t p = 0; p < entries.size();) {
+    const int row = entries[p].row;
+    const int col = entries[p].col;
+    double value = 0;
+    for (; (p < entries.size()) && (entries[p].row == row) &&
+           (entries[p].col == col);
+         ++p) {
+      value += entries[p].value;
+    }
+    if (fabs(value) > threshold) {
+      res.col_idx_.push_back(col);
+      res.values_.push_back(value);
+      ++res.row_ptr_[row + 1];
+    }
+  }
+
+  for (int i = 0; i < rows_; ++i) {
+    res.row_ptr_[i + 1] += res.row_ptr_[i];
+  }
+
+  return res;
+}
@@ -0,0 +1,83 @@
+#ifndef S21_MATRIX_SPARSE_H_
+#define S21_MATRIX_SPARSE_H_
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Compressed sparse row matrix. Row i owns the entries
+// [row_ptr[i], row_ptr[i + 1]) of col_idx and values, sorted by column.
+// Memory and every operation scale with the number of stored entries.
+class S21SparseMatrix {
+ public:
+  // Constructors
+  S21SparseMatrix();
+  S21SparseMatrix(int rows, int cols);
+  // Keeps the elements of dense whose magnitude exceeds threshold.
+  explicit S21SparseMatrix(const S21Matrix& dense,
+                           const double threshold = S21Tolerance<double>::kEps);
+
+  // Accessors
+  int getRows() const noexcept;
+  int getCols() const noexcept;
+  int getNonZeros() const noexcept;
+  const std::vector<int>& getRowPtr() const noexcept;
+  const std::vector<int>& getColIdx() const noexcept;
+  const std::vector<double>& getValues() const noexcept;
+
+  // Functions
+  S21Matrix ToDense() const;
+  bool EqMatrix(const S21SparseMatrix& other) const noexcept;
+  // An entry stored in only one operand is kept as is; one stored in both
+  // is dropped when the sum cancels to within kEps.
+  void SumMatrix(const S21SparseMatrix& other);
+  void SubMatrix(const S21SparseMatrix& other);
+  void MulNumber(const double num) noexcept;
+  S21Matrix MulMatrix(const S21Matrix& dense) const;
+  std::vector<double> MulVector(const std::vector<double>& x) const;
+  S21SparseMatrix Transpose() const;
+
+  // Operators
+  S21SparseMatrix operator+(const S21SparseMatrix& other) const;
+  S21SparseMatrix operator-(const S21SparseMatrix& other) const;
+  S21Matrix operator*(const S21Matrix& dense) const;
+  std::vector<double> operator*(const std::vector<double>& x) const;
+  S21SparseMatrix operator*(const double num) const;
+  bool operator==(const S21SparseMatrix& other) const noexcept;
+  double operator()(const int i, const int j) const;
+
+ private:
+  friend class S21SparseBuilder;
+
+  int rows_, cols_;
+  std::vector<int> row_ptr_;
+  std::vector<int> col_idx_;
+  std::vector<double> values_;
+
+  void merge(const S21SparseMatrix& other, const double sign);
+};
+
+// Coordinate-list builder: collect (i, j, value) triplets in any order and
+// compress them into CSR. Duplicate coordinates are summed.
+class S21SparseBuilder {
+ public:
+  S21SparseBuilder(int rows, int cols);
+
+  void Add(const int i, const int j, const double value);
+  void Reserve(const int count);
+
+  // Entries whose summed magnitude does not exceed threshold are dropped.
+  S21SparseMatrix Build(
+      const double threshold = S21Tolerance<double>::kEps) const;
+
+ private:
+  struct Entry {
+    int row, col;
+    double value;
+  };
+
+  int rows_, cols_;
+  std::vector<Entry> entries_;
+};
+
+#endif  // S21_MATRIX_SPARSE_H_
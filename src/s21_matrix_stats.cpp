@@ -0,0 +1,224 @@
+#include "s21_matrix_stats.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+constexpr int kOps = static_cast<int>(S21Op::kCount);
+
+// Counters of one thread. Only the owner adds to them; snapshots from
+// other threads read them concurrently, hence the relaxed atomics.
+struct Counters {
+  std::atomic<std::uint64_t> calls[kOps];
+  std::atomic<std::uint64_t> nanoseconds[kOps];
+  std::atomic<std::uint64_t> flops[kOps];
+  std::atomic<std::uint64_t> alloc_bytes;
+  std::atomic<std::uint64_t> alloc_count;
+
+  Counters() noexcept { Reset(); }
+
+  void Reset() noexcept {
+    for (int i = 0; i < kOps; ++i) {
+      calls[i].store(0, std::memory_order_relaxed);
+      nanoseconds[i].store(0, std::memory_order_relaxed);
+      flops[i].store(0, std::memory_order_relaxed);
+    }
+    alloc_bytes.store(0, std::memory_order_relaxed);
+    alloc_count.store(0, std::memory_order_relaxed);
+  }
+
+  void AddTo(S21StatsSnapshot& snapshot) const noexcept {
+    for (int i = 0; i < kOps; ++i) {
+      snapshot.ops[i].calls += calls[i].load(std::memory_order_relaxed);
+      snapshot.ops[i].nanoseconds +=
+          nanoseconds[i].load(std::memory_order_relaxed);
+      snapshot.ops[i].flops += flops[i].load(std::memory_order_relaxed);
+    }
+    snapshot.alloc_bytes += alloc_bytes.load(std::memory_order_relaxed);
+    snapshot.alloc_count += alloc_count.load(std::memory_order_relaxed);
+  }
+};
+
+// Live thread blocks plus the totals of exited threads. Leaked so that
+// thread blocks destroyed during exit can still unregister.
+struct Registry {
+  std::mutex mutex;
+  std::vector<Counters*> threads;
+  S21StatsSnapshot retired;
+
+  static Registry& Instance() {
+    static Registry* registry = new Registry;
+    return *registry;
+  }
+};
+
+struct ThreadCounters {
+  Counters counters;
+
+  ThreadCounters() {
+    Registry& registry = Registry::Instance();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.threads.push_back(&counters);
+  }
+
+  ~ThreadCounters() {
+    Registry& registry = Registry::Instance();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    counters.AddTo(registry.retired);
+    registry.threads.erase(std::find(registry.threads.begin(),
+                                     registry.threads.end(), &counters));
+  }
+};
+
+Counters& threadCounters() {
+  thread_local ThreadCounters block;
+  return block.counters;
+}
+
+void add(std::atomic<std::uint64_t>& counter,
+         const std::uint64_t value) noexcept {
+  counter.fetch_add(value, std::memory_order_relaxed);
+}
+
+}  // namespace
+
+const char* s21_op_name(const S21Op op) noexcept {
+  static const char* const kNames[kOps] = {
+      "EqMatrix",    "SumMatrix",     "SubMatrix", "MulNumber",
+      "MulMatrix",   "Transpose",     "CalcComplements",
+      "Determinant", "InverseMatrix", "Minor",     "Expression",
+      "Solve",       "LeastSquares"};
+  const int index = static_cast<int>(op);
+  return (index >= 0) && (index < kOps) ? kNames[index] : "Unknown";
+}
+
+S21StatsSnapshot S21StatsSnapshot::operator-(
+    const S21StatsSnapshot& other) const noexcept {
+  S21StatsSnapshot res;
+  for (int i = 0; i < kOps; ++i) {
+    res.ops[i].calls = ops[i].calls - other.ops[i].calls;
+    res.ops[i].nanoseconds = ops[i].nanoseconds - other.ops[i].nanoseconds;
+    res.ops[i].flops = ops[i].flops - other.ops[i].flops;
+  }
+  res.alloc_bytes = alloc_bytes - other.alloc_bytes;
+  res.alloc_count = alloc_count - other.alloc_count;
+  return res;
+}
+
+bool s21_stats_enabled() noexcept {
+#ifdef S21_MATRIX_STATS
+  return true;
+#else
+  return false;
+#endif
+}
+
+S21StatsSnapshot s21_stats_snapshot() {
+  Registry& registry = Registry::Instance();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  S21StatsSnapshot snapshot = registry.retired;
+  for (const Counters* counters : registry.threads) {
+    counters->AddTo(snapshot);
+  }
+
+  return snapshot;
+}
+
+S21StatsSnapshot s21_thread_stats_snapshot() noexcept {
+  S21StatsSnapshot snapshot;
+  threadCounters().AddTo(snapshot);
+  return snapshot;
+}
+
+void s21_stats_reset() {
+  Registry& registry = Registry::Instance();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  registry.retired = S21StatsSnapshot();
+  for (Counters* counters : registry.threads) {
+    counters->Reset();
+  }
+}
+
+std::string s21_stats_prometheus(const S21StatsSnapshot& snapshot) {
+  std::string text;
+  char line[160];
+
+  auto family = [&](const char* name, const char* help) {
+    text += "# HELP ";
+    text += name;
+    text += ' ';
+    text += help;
+    text += "\n# TYPE ";
+    text += name;
+    text += " counter\n";
+  };
+
+  family("s21_matrix_calls_total", "S21Matrix operation calls.");
+  for (int i = 0; i < kOps; ++i) {
+    std::snprintf(line, sizeof(line),
+                  "s21_matrix_calls_total{op=\"%s\"} %llu\n",
+                  s21_op_name(static_cast<S21Op>(i)),
+                  static_cast<unsigned long long>(snapshot.ops[i].calls));
+    text += line;
+  }
+
+  family("s21_matrix_seconds_total",
+         "Wall time spent in S21Matrix operations.");
+  for (int i = 0; i < kOps; ++i) {
+    std::snprintf(line, sizeof(line),
+                  "s21_matrix_seconds_total{op=\"%s\"} %.9f\n",
+                  s21_op_name(static_cast<S21Op>(i)),
+                  snapshot.ops[i].nanoseconds * 1e-9);
+    text += line;
+  }
+
+  family("s21_matrix_flops_total",
+         "Nominal floating point operations of S21Matrix operations.");
+  for (int i = 0; i < kOps; ++i) {
+    std::snprintf(line, sizeof(line),
+                  "s21_matrix_flops_total{op=\"%s\"} %llu\n",
+                  s21_op_name(static_cast<S21Op>(i)),
+                  static_cast<unsigned long long>(snapshot.ops[i].flops));
+    text += line;
+  }
+
+  family("s21_matrix_alloc_bytes_total", "Bytes of matrix buffers allocated.");
+  std::snprintf(line, sizeof(line), "s21_matrix_alloc_bytes_total %llu\n",
+                static_cast<unsigned long long>(snapshot.alloc_bytes));
+  text += line;
+
+  family("s21_matrix_allocs_total", "Matrix buffers allocated.");
+  std::snprintf(line, sizeof(line), "s21_matrix_allocs_total %llu\n",
+                static_cast<unsigned long long>(snapshot.alloc_count));
+  text += line;
+
+  return text;
+}
+
+S21StatsScope::S21StatsScope() noexcept
+    : start_(s21_thread_stats_snapshot()) {}
+
+S21StatsSnapshot S21StatsScope::Elapsed() const noexcept {
+  return s21_thread_stats_snapshot() - start_;
+}
+
+void s21_stats_record(const S21Op op, const std::uint64_t nanoseconds,
+                      const std::uint64_t flops) noexcept {
+  Counters& counters = threadCounters();
+  const int index = static_cast<int>(op);
+  add(counters.calls[index], 1);
+  add(counters.nanoseconds[index], nanoseconds);
+  add(counters.flops[index], flops);
+}
+
+void s21_stats_record_alloc(const std::size_t bytes) noexcept {
+  Counters& counters = threadCounters();
+  add(counters.alloc_bytes, bytes);
+  add(counters.alloc_count, 1);
+}
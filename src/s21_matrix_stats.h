@@ -0,0 +1,121 @@
+#ifndef S21_MATRIX_STATS_H_
+#define S21_MATRIX_STATS_H_
+
+// Optional operation counters. Building with -DS21_MATRIX_STATS (make
+// STATS_FLAGS=-DS21_MATRIX_STATS) makes every instrumented S21Matrix
+// operation record its call count, wall time and nominal FLOPs, and every
+// matrix buffer allocation its size. Without the define the recording
+// macros expand to nothing and the snapshots below stay zero.
+//
+// Counters live in a per-thread block, so recording never contends; a
+// process-wide snapshot sums the blocks of all live and exited threads.
+// Times are inclusive: an operation built on others (CalcComplements calls
+// Determinant) counts its callees too.
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+enum class S21Op : int {
+  kEqMatrix,
+  kSumMatrix,
+  kSubMatrix,
+  kMulNumber,
+  kMulMatrix,
+  kTranspose,
+  kCalcComplements,
+  kDeterminant,
+  kInverseMatrix,
+  kMinor,
+  kExpression,
+  kSolve,
+  kLeastSquares,
+  kCount
+};
+
+const char* s21_op_name(const S21Op op) noexcept;
+
+struct S21OpStats {
+  std::uint64_t calls = 0;
+  std::uint64_t nanoseconds = 0;
+  std::uint64_t flops = 0;
+};
+
+struct S21StatsSnapshot {
+  S21OpStats ops[static_cast<int>(S21Op::kCount)];
+  std::uint64_t alloc_bytes = 0;
+  std::uint64_t alloc_count = 0;
+
+  const S21OpStats& operator[](const S21Op op) const noexcept {
+    return ops[static_cast<int>(op)];
+  }
+
+  // Counter-wise difference, for measuring an interval.
+  S21StatsSnapshot operator-(const S21StatsSnapshot& other) const noexcept;
+};
+
+// True if the library was built with S21_MATRIX_STATS.
+bool s21_stats_enabled() noexcept;
+
+// Counters of all threads, or of the calling thread only.
+S21StatsSnapshot s21_stats_snapshot();
+S21StatsSnapshot s21_thread_stats_snapshot() noexcept;
+
+// Zeroes the counters of all threads.
+void s21_stats_reset();
+
+// Prometheus text exposition format: counters s21_matrix_calls_total,
+// s21_matrix_seconds_total and s21_matrix_flops_total labelled by op, plus
+// s21_matrix_alloc_bytes_total and s21_matrix_allocs_total.
+std::string s21_stats_prometheus(const S21StatsSnapshot& snapshot);
+
+// Work done by the calling thread since construction; per-thread scoping
+// that is unaffected by other threads.
+class S21StatsScope {
+ public:
+  S21StatsScope() noexcept;
+
+  S21StatsSnapshot Elapsed() const noexcept;
+
+ private:
+  S21StatsSnapshot start_;
+};
+
+// Recording, used through the macros below.
+void s21_stats_record(const S21Op op, const std::uint64_t nanoseconds,
+                      const std::uint64_t flops) noexcept;
+void s21_stats_record_alloc(const std::size_t bytes) noexcept;
+
+class S21StatsTimer {
+ public:
+  S21StatsTimer(const S21Op op, const std::uint64_t flops) noexcept
+      : op_(op), flops_(flops), start_(std::chrono::steady_clock::now()) {}
+  S21StatsTimer(const S21StatsTimer&) = delete;
+  S21StatsTimer& operator=(const S21StatsTimer&) = delete;
+
+  ~S21StatsTimer() {
+    const auto elapsed = std::chrono::steady_clock::now() - start_;
+    s21_stats_record(
+        op_,
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+        flops_);
+  }
+
+ private:
+  S21Op op_;
+  std::uint64_t flops_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+#ifdef S21_MATRIX_STATS
+// Times the rest of the enclosing block as one call of op.
+#define S21_STATS_OP(op, flops) \
+  const S21StatsTimer s21_stats_timer_((op), static_cast<std::uint64_t>(flops))
+#define S21_STATS_ALLOC(bytes) s21_stats_record_alloc(bytes)
+#else
+#define S21_STATS_OP(op, flops) ((void)0)
+#define S21_STATS_ALLOC(bytes) ((void)0)
+#endif
+
+#endif  // S21_MATRIX_STATS_H_
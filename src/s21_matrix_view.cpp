@@ -0,0 +1,45 @@
+#include "s21_matrix_oop.h"
+
+template <typename T>
+S21BasicMatrixView<T>::S21BasicMatrixView(
+    const S21BasicMatrix<T>& matrix) noexcept
+    : S21BasicMatrixView(matrix.matrix_, matrix.rows_, matrix.cols_,
+                         matrix.stride_, -1, -1, false) {}
+
+template <typename T>
+S21BasicMatrixView<T>::S21BasicMatrixView(const T* data, const int rows,
+                                          const int cols, const int stride,
+                                          const int skip_row,
+                                          const int skip_col,
+                                          const bool transposed) noexcept
+    : data_(data),
+      rows_(rows),
+      cols_(cols),
+      stride_(stride),
+      skip_row_(skip_row),
+      skip_col_(skip_col),
+      transposed_(transposed) {}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrixView<T>::Transpose() const noexcept {
+  S21BasicMatrixView view(*this);
+  view.transposed_ = !transposed_;
+  return view;
+}
+
+template <typename T>
+T S21BasicMatrixView<T>::operator()(const int i, const int j) const {
+  if ((i < 0) || (i > getRows() - 1)) {
+    throw std::out_of_range("i argument out of range");
+  }
+
+  if ((j < 0) || (j > getCols() - 1)) {
+    throw std::out_of_range("j argument out of range");
+  }
+
+  return At(i, j);
+}
+
+template class S21BasicMatrixView<float>;
+template class S21BasicMatrixView<double>;
+template class S21BasicMatrixView<long double>;
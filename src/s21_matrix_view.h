@@ -0,0 +1,71 @@
+#ifndef S21_MATRIX_VIEW_H_
+#define S21_MATRIX_VIEW_H_
+
+// Non-owning read-only window into an S21BasicMatrix. Included at the end of
+// s21_matrix_oop.h; do not include it directly.
+//
+// A view can select a block, drop one row and one column (as Minor() does)
+// and be transposed, all without copying. It is invalidated when the
+// source matrix is resized, reassigned or destroyed.
+template <typename T>
+class S21BasicMatrixView : public S21Expr<S21BasicMatrixView<T>> {
+ public:
+  using value_type = T;
+
+  S21BasicMatrixView(const S21BasicMatrix<T>& matrix) noexcept;
+
+  // Accessors
+  int getRows() const noexcept { return transposed_ ? cols_ : rows_; }
+  int getCols() const noexcept { return transposed_ ? rows_ : cols_; }
+  int getStride() const noexcept { return stride_; }
+  const T* getData() const noexcept { return data_; }
+  bool isTransposed() const noexcept { return transposed_; }
+
+  // True for an untransposed view without excluded rows or columns, which
+  // is a plain strided block.
+  bool isContiguous() const noexcept {
+    return !transposed_ && (skip_row_ < 0) && (skip_col_ < 0);
+  }
+
+  // Functions
+  S21BasicMatrixView Transpose() const noexcept;
+  T operator()(const int i, const int j) const;
+
+  T At(int i, int j) const noexcept {
+    if (transposed_) {
+      const int tmp = i;
+      i = j;
+      j = tmp;
+    }
+    i += (skip_row_ >= 0) && (i >= skip_row_);
+    j += (skip_col_ >= 0) && (j >= skip_col_);
+    return data_[i * stride_ + j];
+  }
+
+  bool Overlaps(const T* begin, const T* end) const noexcept {
+    const T* last = data_ + (rows_ + (skip_row_ >= 0) - 1) * stride_ +
+                         cols_ + (skip_col_ >= 0);
+    return (data_ < end) && (begin < last);
+  }
+
+ private:
+  friend class S21BasicMatrix<T>;
+  friend class S21MappedMatrix;
+
+  const T* data_;
+  int rows_, cols_, stride_;
+  int skip_row_, skip_col_;
+  bool transposed_;
+
+  S21BasicMatrixView(const T* data, const int rows, const int cols,
+                     const int stride, const int skip_row, const int skip_col,
+                     const bool transposed) noexcept;
+};
+
+using S21MatrixView = S21BasicMatrixView<double>;
+
+extern template class S21BasicMatrixView<float>;
+extern template class S21BasicMatrixView<double>;
+extern template class S21BasicMatrixView<long double>;
+
+#endif  // S21_MATRIX_VIEW_H_
@@ -1,6 +1,34 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <numeric>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "s21_matrix_alloc.h"
+#include "s21_matrix_async.h"
+#include "s21_matrix_batch.h"
+#include "s21_matrix_cholesky.h"
+#include "s21_matrix_fixed.h"
+#include "s21_matrix_gemm.h"
+#include "s21_matrix_io.h"
+#include "s21_matrix_lu.h"
+#include "s21_matrix_ooc.h"
 #include "s21_matrix_oop.h"
+#include "s21_matrix_parallel.h"
+#include "s21_matrix_qr.h"
+#include "s21_matrix_simd.h"
+#include "s21_matrix_solve.h"
+#include "s21_matrix_sparse.h"
+#include "s21_matrix_stats.h"
 
 TEST(S21MatrixTest, DefaultConstructor) {
   S21Matrix mat;
@@ -264,6 +292,39 @@ TEST(S21MatrixTest, MulMatrix_1) {
   EXPECT_TRUE(mat3.EqMatrix(mat1));
 }
 
+TEST(S21MatrixTest, MulMatrix_2) {
+  const int m = 103, k = 300, n = 131;
+  S21Matrix mat1(m, k);
+  S21Matrix mat2(k, n);
+  for (int i = 0; i < m; ++i) {
+    for (int j = 0; j < k; ++j) {
+      mat1(i, j) = ((i * 7 + j * 3) % 17) * 0.25 - 2;
+    }
+  }
+  for (int i = 0; i < k; ++i) {
+    for (int j = 0; j < n; ++j) {
+      mat2(i, j) = ((i * 5 + j * 11) % 13) * 0.5 - 3;
+    }
+  }
+
+  S21Matrix mat3(m, n);
+  for (int i = 0; i < m; ++i) {
+    for (int j = 0; j < n; ++j) {
+      double sum = 0;
+      for (int p = 0; p < k; ++p) {
+        sum += mat1(i, p) * mat2(p, j);
+      }
+      mat3(i, j) = sum;
+    }
+  }
+
+  mat1.MulMatrix(mat2);
+
+  EXPECT_EQ(mat1.getRows(), m);
+  EXPECT_EQ(mat1.getCols(), n);
+  EXPECT_TRUE(mat3.EqMatrix(mat1));
+}
+
 TEST(S21MatrixTest, Minor_0) {
   S21Matrix mat1(2, 2);
   EXPECT_THROW(S21Matrix mat2 = mat1.Minor(2, 1), std::out_of_range);
@@ -358,6 +419,56 @@ TEST(S21MatrixTest, CalcComplements_2) {
   EXPECT_TRUE(mat3.EqMatrix(mat2));
 }
 
+static S21Matrix BruteComplements(S21Matrix& mat) {
+  S21Matrix res(mat.getRows(), mat.getCols());
+  for (int i = 0; i < mat.getRows(); ++i) {
+    for (int j = 0; j < mat.getCols(); ++j) {
+      res(i, j) = mat.Minor(i, j).Determinant() * ((i + j) % 2 ? -1 : 1);
+    }
+  }
+  return res;
+}
+
+TEST(S21MatrixTest, CalcComplements_3) {
+  S21Matrix mat1(5, 5);
+  for (int i = 0; i < 5; ++i) {
+    for (int j = 0; j < 5; ++j) {
+      mat1(i, j) = ((i * 5 + j * 3) % 7) - 3 + (i == j);
+    }
+  }
+
+  EXPECT_TRUE(mat1.CalcComplements().EqMatrix(BruteComplements(mat1)));
+}
+
+TEST(S21MatrixTest, CalcComplements_4) {
+  // Rank 4: the last row is a combination of the others.
+  S21Matrix mat1(5, 5);
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 5; ++j) {
+      mat1(i, j) = ((i * 5 + j * 3) % 7) - 3 + (i == j);
+    }
+  }
+  for (int j = 0; j < 5; ++j) {
+    mat1(4, j) = 2 * mat1(0, j) - mat1(2, j) + 0.5 * mat1(3, j);
+  }
+
+  S21Matrix mat2 = mat1.CalcComplements();
+  EXPECT_TRUE(mat2.EqMatrix(BruteComplements(mat1)));
+  EXPECT_FALSE(mat2.EqMatrix(S21Matrix(5, 5)));
+}
+
+TEST(S21MatrixTest, CalcComplements_5) {
+  // Rank 2: all cofactors of a 4x4 vanish.
+  S21Matrix mat1(4, 4);
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      mat1(i, j) = (i + 1) * (j + 2) + (i % 2) * j;
+    }
+  }
+
+  EXPECT_TRUE(mat1.CalcComplements().EqMatrix(S21Matrix(4, 4)));
+}
+
 TEST(S21MatrixTest, Inverse_0) {
   S21Matrix mat1(3, 3);
   mat1(0, 0) = 0;
@@ -635,6 +746,1778 @@ TEST(S21MatrixTest, OperatorMinus) {
   EXPECT_TRUE(mat3 == mat4);
 }
 
+TEST(S21MatrixTest, Storage_0) {
+  S21Matrix mat(3, 5);
+  EXPECT_GE(mat.getStride(), mat.getCols());
+  EXPECT_EQ(mat.getStride() % 8, 0);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&mat(1, 0)) % 64, 0u);
+}
+
+TEST(S21MatrixTest, Storage_1) {
+  S21Matrix mat(2, 3);
+  for (int i = 0; i < 2; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      mat(i, j) = i * 3 + j;
+    }
+  }
+
+  mat.setCols(10);
+  mat.setRows(3);
+  EXPECT_DOUBLE_EQ(mat(1, 2), 5);
+  EXPECT_DOUBLE_EQ(mat(1, 9), 0);
+  EXPECT_DOUBLE_EQ(mat(2, 0), 0);
+
+  mat.setCols(2);
+  EXPECT_DOUBLE_EQ(mat(1, 1), 4);
+}
+
+TEST(S21MatrixTest, Storage_2) {
+  S21Matrix mat1(2, 9);
+  mat1(1, 8) = 7;
+
+  S21Matrix mat2(4, 1);
+  mat2 = mat1;
+  EXPECT_EQ(mat2.getRows(), 2);
+  EXPECT_EQ(mat2.getCols(), 9);
+  EXPECT_EQ(mat2.getStride(), mat1.getStride());
+  EXPECT_DOUBLE_EQ(mat2(1, 8), 7);
+}
+
+TEST(S21MatrixTest, Determinant_2) {
+  const int n = 40;
+  S21Matrix mat1(n, n);
+  for (int i = 0; i < n; ++i) {
+    mat1(i, i) = 2;
+    if (i > 0) {
+      mat1(i, i - 1) = -1;
+      mat1(i - 1, i) = -1;
+    }
+  }
+
+  EXPECT_NEAR(mat1.Determinant(), n + 1, 1e-9);
+}
+
+TEST(S21MatrixTest, Determinant_3) {
+  S21Matrix mat1(3, 3);
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      mat1(i, j) = i * 3 + j;
+    }
+  }
+
+  EXPECT_NEAR(mat1.Determinant(), 0, S21Tolerance<double>::kEps);
+}
+
+TEST(S21LUTest, Factorization) {
+  S21Matrix mat1(4, 4);
+  const double values[16] = {1, 2,  3,  4, 5,  6, 7, 9,
+                             2, -1, 10, 3, -7, 1, 0, 2};
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      mat1(i, j) = values[i * 4 + j];
+    }
+  }
+
+  S21LU lu(mat1);
+  const S21Matrix& packed = lu.getLU();
+  EXPECT_EQ(lu.getSize(), 4);
+  EXPECT_FALSE(lu.IsSingular());
+
+  S21Matrix l(4, 4);
+  S21Matrix u(4, 4);
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      if (i > j) {
+        l(i, j) = packed(i, j);
+      } else {
+        u(i, j) = packed(i, j);
+      }
+    }
+    l(i, i) = 1;
+  }
+
+  S21Matrix permuted(mat1);
+  for (int k = 0; k < 4; ++k) {
+    int p = lu.getPivots()[k];
+    for (int j = 0; j < 4; ++j) {
+      std::swap(permuted(k, j), permuted(p, j));
+    }
+  }
+
+  EXPECT_TRUE((l * u).EqMatrix(permuted));
+  EXPECT_NEAR(lu.Determinant(), mat1.Determinant(), 1e-9);
+}
+
+TEST(S21MatrixTest, Inverse_2) {
+  EXPECT_THROW(S21Matrix(2, 3).InverseMatrix(), std::domain_error);
+}
+
+TEST(S21MatrixTest, Inverse_3) {
+  const int n = 60;
+  S21Matrix mat1(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      mat1(i, j) = (i == j) ? n : ((i * 7 + j * 13) % 11) - 5;
+    }
+  }
+
+  S21Matrix identity(n, n);
+  for (int i = 0; i < n; ++i) {
+    identity(i, i) = 1;
+  }
+
+  S21Matrix inverse = mat1.InverseMatrix();
+  EXPECT_TRUE((mat1 * inverse).EqMatrix(identity));
+  EXPECT_TRUE((inverse * mat1).EqMatrix(identity));
+}
+
+TEST(S21MatrixTest, Inverse_4) {
+  S21Matrix mat1(1, 1);
+  mat1(0, 0) = 4;
+  EXPECT_DOUBLE_EQ(mat1.InverseMatrix()(0, 0), 0.25);
+}
+
+TEST(S21LUTest, Singular) {
+  S21Matrix mat1(2, 2);
+  mat1(0, 0) = 1;
+  mat1(0, 1) = 2;
+  mat1(1, 0) = 2;
+  mat1(1, 1) = 4;
+
+  S21LU lu(mat1);
+  EXPECT_TRUE(lu.IsSingular());
+  EXPECT_DOUBLE_EQ(lu.Determinant(), 0);
+  EXPECT_THROW(lu.Inverse(), std::domain_error);
+  EXPECT_THROW(S21LU lu2(S21Matrix(2, 3)), std::domain_error);
+}
+
+TEST(S21LUTest, ScaledDiagonal) {
+  S21Matrix mat1(2, 2);
+  mat1(0, 0) = 1e-7;
+  mat1(1, 1) = 1e8;
+
+  S21LU lu(mat1);
+  EXPECT_FALSE(lu.IsSingular());
+  EXPECT_NEAR(mat1.Determinant(), 10, 1e-9);
+
+  S21Matrix inverse = mat1.InverseMatrix();
+  EXPECT_NEAR(inverse(0, 0), 1e7, 1e-3);
+  EXPECT_NEAR(inverse(1, 1), 1e-8, 1e-20);
+  EXPECT_EQ(inverse(0, 1), 0);
+  EXPECT_EQ(inverse(1, 0), 0);
+
+  S21Matrix b(2, 1);
+  b(0, 0) = 1;
+  b(1, 0) = 1;
+  S21Matrix x = lu.Solve(b);
+  EXPECT_NEAR(x(0, 0), 1e7, 1e-3);
+  EXPECT_NEAR(x(1, 0), 1e-8, 1e-20);
+
+  mat1(0, 0) = mat1(0, 1) = mat1(1, 0) = 1e8;
+  mat1(1, 1) = 1e8 + 1e-4;
+  EXPECT_TRUE(S21LU(mat1).IsSingular());
+}
+
+TEST(S21SimdTest, KernelsMatchScalar) {
+  const int rows = 5, cols = 19, stride = 24;
+  double a[rows * stride];
+  double b[rows * stride];
+  for (int i = 0; i < rows * stride; ++i) {
+    a[i] = (i % 13) * 0.5 - 3;
+    b[i] = (i % 7) * 1.25 - 4;
+  }
+
+  const S21SimdKernels* scalar = s21_simd_kernels(S21SimdLevel::kScalar);
+  const S21SimdLevel levels[] = {S21SimdLevel::kSSE2, S21SimdLevel::kAVX2,
+                                 S21SimdLevel::kAVX512};
+
+  for (S21SimdLevel level : levels) {
+    const S21SimdKernels* kernels = s21_simd_kernels(level);
+    if (kernels == nullptr) {
+      continue;
+    }
+
+    double expected[rows * stride];
+    double actual[rows * stride];
+    std::copy(a, a + rows * stride, expected);
+    std::copy(a, a + rows * stride, actual);
+
+    scalar->add(expected, b, rows, cols, stride, stride);
+    kernels->add(actual, b, rows, cols, stride, stride);
+    scalar->scale(expected, -1.5, rows, cols, stride);
+    kernels->scale(actual, -1.5, rows, cols, stride);
+    scalar->sub(expected, b, rows, cols, stride, stride);
+    kernels->sub(actual, b, rows, cols, stride, stride);
+
+    for (int i = 0; i < rows * stride; ++i) {
+      EXPECT_DOUBLE_EQ(expected[i], actual[i]) << kernels->name;
+    }
+
+    EXPECT_TRUE(kernels->equal(expected, actual, rows, cols, stride, stride,
+                               S21Tolerance<double>::kEps));
+    actual[4 * stride + 18] += 2 * S21Tolerance<double>::kEps;
+    EXPECT_FALSE(kernels->equal(expected, actual, rows, cols, stride, stride,
+                                S21Tolerance<double>::kEps));
+    actual[4 * stride + 18] = expected[4 * stride + 18];
+    actual[4 * stride + 20] += 1;
+    EXPECT_TRUE(kernels->equal(expected, actual, rows, cols, stride, stride,
+                               S21Tolerance<double>::kEps));
+  }
+}
+
+TEST(S21SimdTest, TransposeMatchesScalar) {
+  // Full register tiles of every width plus ragged edges.
+  const int rows = 21, cols = 19, src_stride = 24, dst_stride = 32;
+  double src[rows * src_stride];
+  for (int i = 0; i < rows * src_stride; ++i) {
+    src[i] = i * 0.25 - 7;
+  }
+
+  const S21SimdLevel levels[] = {S21SimdLevel::kScalar, S21SimdLevel::kSSE2,
+                                 S21SimdLevel::kAVX2, S21SimdLevel::kAVX512};
+
+  for (S21SimdLevel level : levels) {
+    const S21SimdKernels* kernels = s21_simd_kernels(level);
+    if (kernels == nullptr) {
+      continue;
+    }
+
+    double dst[cols * dst_stride] = {};
+    kernels->transpose(dst, src, rows, cols, dst_stride, src_stride);
+
+    for (int i = 0; i < rows; ++i) {
+      for (int j = 0; j < cols; ++j) {
+        EXPECT_EQ(dst[j * dst_stride + i], src[i * src_stride + j])
+            << kernels->name << " " << i << " " << j;
+      }
+    }
+    EXPECT_EQ(dst[rows], 0) << kernels->name;
+  }
+}
+
+class CountingExecutor : public S21Executor {
+ public:
+  int Concurrency() const noexcept override { return 3; }
+  void ParallelFor(const int count,
+                   const std::function<void(int)>& task) override {
+    calls_++;
+    for (int i = count - 1; i >= 0; --i) {
+      task(i);
+    }
+  }
+  int calls_ = 0;
+};
+
+static S21Matrix Filled(const int rows, const int cols, const int seed) {
+  S21Matrix mat(rows, cols);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      mat(i, j) = ((i * 31 + j * 17 + seed) % 23) * 0.125 - 1;
+    }
+  }
+  return mat;
+}
+
+TEST(S21MatrixTest, Expression_0) {
+  S21Matrix a = Filled(20, 30, 1);
+  S21Matrix b = Filled(20, 30, 2);
+  S21Matrix c = Filled(20, 30, 3);
+
+  S21Matrix expected(a);
+  S21Matrix scaled(b);
+  scaled.MulNumber(2.0);
+  expected.SumMatrix(scaled);
+  expected.SubMatrix(c);
+
+  S21Matrix res = a + b * 2.0 - c;
+  EXPECT_TRUE(res.EqMatrix(expected));
+
+  res = 0.5 * (a - c) + (a + b).Eval();
+  EXPECT_DOUBLE_EQ(res(3, 4),
+                   0.5 * (a(3, 4) - c(3, 4)) + a(3, 4) + b(3, 4));
+}
+
+TEST(S21MatrixTest, Expression_1) {
+  S21Matrix a = Filled(4, 5, 1);
+  S21Matrix b = Filled(4, 5, 2);
+  S21Matrix a_copy(a);
+
+  a = a * 3.0 - b;
+  EXPECT_DOUBLE_EQ(a(2, 3), a_copy(2, 3) * 3.0 - b(2, 3));
+
+  a += b * 2.0;
+  a -= a_copy + b;
+  EXPECT_DOUBLE_EQ(a(1, 4), 2 * a_copy(1, 4));
+
+  S21Matrix small(1, 1);
+  small = a + b;
+  EXPECT_EQ(small.getRows(), 4);
+  EXPECT_EQ(small.getCols(), 5);
+}
+
+TEST(S21MatrixTest, Expression_2) {
+  S21Matrix a = Filled(3, 4, 1);
+  S21Matrix b = Filled(4, 2, 2);
+  S21Matrix c = Filled(3, 4, 3);
+
+  EXPECT_THROW(S21Matrix res = a + b, std::invalid_argument);
+  EXPECT_THROW(S21Matrix res = a - b * 2.0, std::invalid_argument);
+
+  S21Matrix expected = (a * 1.0).Eval();
+  expected.SumMatrix(c);
+  expected.MulMatrix(b);
+  EXPECT_TRUE(((a + c) * b).EqMatrix(expected));
+  EXPECT_EQ((a + c).getCols(), 4);
+}
+
+TEST(S21MatrixTest, Expression_3) {
+  // Call forms that compiled when the operators returned S21Matrix.
+  S21Matrix a = Filled(3, 3, 1);
+  S21Matrix b = Filled(3, 3, 2);
+  for (int i = 0; i < 3; ++i) {
+    a(i, i) += 5;
+  }
+  S21Matrix sum = a;
+  sum.SumMatrix(b);
+  S21Matrix difference = a;
+  difference.SubMatrix(b);
+
+  EXPECT_DOUBLE_EQ((a + b)(0, 0), sum(0, 0));
+  EXPECT_DOUBLE_EQ((a * 2.0)(2, 1), 2 * a(2, 1));
+  EXPECT_THROW((a + b)(3, 0), std::out_of_range);
+  EXPECT_THROW((a + b)(0, -1), std::out_of_range);
+  EXPECT_EQ((a - b).getRows(), 3);
+  EXPECT_DOUBLE_EQ((a - b).Determinant(), difference.Determinant());
+  EXPECT_TRUE((a - b).InverseMatrix().EqMatrix(difference.InverseMatrix()));
+  EXPECT_TRUE((a + b).Transpose().EqMatrix(sum.Transpose()));
+  EXPECT_TRUE(
+      (a - b).CalcComplements().EqMatrix(difference.CalcComplements()));
+  EXPECT_TRUE((a + b).Minor(1, 1).EqMatrix(sum.Minor(1, 1)));
+  EXPECT_TRUE((a + b).EqMatrix(sum));
+  EXPECT_TRUE((a + b) == sum);
+  EXPECT_FALSE((a - b) == sum);
+}
+
+TEST(S21MatrixTest, MoveAssignment) {
+  static_assert(std::is_nothrow_move_constructible<S21Matrix>::value, "");
+  static_assert(std::is_nothrow_move_assignable<S21Matrix>::value, "");
+
+  S21Matrix mat1 = Filled(3, 4, 1);
+  const double* buffer = &mat1(0, 0);
+
+  S21Matrix mat2(2, 2);
+  mat2 = std::move(mat1);
+  EXPECT_EQ(&mat2(0, 0), buffer);
+  EXPECT_EQ(mat2.getRows(), 3);
+  EXPECT_EQ(mat2.getCols(), 4);
+
+  mat1 = mat2;
+  EXPECT_TRUE(mat1.EqMatrix(mat2));
+
+  std::vector<S21Matrix> matrices(1, Filled(2, 2, 1));
+  const double* first = &matrices[0](0, 0);
+  matrices.resize(10);
+  EXPECT_EQ(&matrices[0](0, 0), first);
+}
+
+TEST(S21MatrixTest, RvalueOperators) {
+  S21Matrix a = Filled(5, 6, 1);
+  S21Matrix b = Filled(5, 6, 2);
+  S21Matrix c = Filled(6, 3, 3);
+
+  S21Matrix tmp(a);
+  const double* buffer = &tmp(0, 0);
+  S21Matrix res = std::move(tmp) + b;
+  EXPECT_EQ(&res(0, 0), buffer);
+  EXPECT_DOUBLE_EQ(res(4, 5), a(4, 5) + b(4, 5));
+
+  buffer = &res(0, 0);
+  res = a - std::move(res);
+  EXPECT_EQ(&res(0, 0), buffer);
+  EXPECT_DOUBLE_EQ(res(4, 5), -b(4, 5));
+
+  buffer = &res(0, 0);
+  res = 2.0 * (std::move(res) * 3.0);
+  EXPECT_EQ(&res(0, 0), buffer);
+  EXPECT_DOUBLE_EQ(res(1, 2), -6 * b(1, 2));
+
+  S21Matrix sum = S21Matrix(a) + S21Matrix(b);
+  EXPECT_TRUE(sum.EqMatrix(a + b));
+  EXPECT_TRUE((S21Matrix(a) * c).EqMatrix(a * c));
+  EXPECT_THROW(S21Matrix(a) - S21Matrix(c), std::invalid_argument);
+}
+
+TEST(S21ParallelTest, ThreadPool) {
+  S21ThreadPool pool(4);
+  EXPECT_EQ(pool.Concurrency(), 4);
+
+  std::vector<int> hits(1000, 0);
+  pool.ParallelFor(1000, [&](int i) { hits[i]++; });
+  EXPECT_EQ(std::count(hits.begin(), hits.end(), 1), 1000);
+
+  EXPECT_THROW(pool.ParallelFor(10,
+                                [](int i) {
+                                  if (i == 7) {
+                                    throw std::runtime_error("task");
+                                  }
+                                }),
+               std::runtime_error);
+  EXPECT_THROW(S21ThreadPool bad(0), std::invalid_argument);
+}
+
+TEST(S21ParallelTest, PoolMatchesSerial) {
+  S21Matrix a = Filled(300, 257, 1);
+  S21Matrix b = Filled(257, 190, 2);
+  S21Matrix c = Filled(300, 257, 3);
+
+  const int threads = s21_get_num_threads();
+  s21_set_num_threads(1);
+  S21Matrix product = a * b;
+  S21Matrix sum = a + c;
+  S21Matrix scaled = a * 3.5;
+  S21Matrix transposed = a.Transpose();
+
+  s21_set_num_threads(4);
+  EXPECT_EQ(s21_get_num_threads(), 4);
+  EXPECT_TRUE(product.EqMatrix(a * b));
+  EXPECT_TRUE(sum.EqMatrix(a + c));
+  EXPECT_TRUE(scaled.EqMatrix(a * 3.5));
+  EXPECT_TRUE(transposed.EqMatrix(a.Transpose()));
+  EXPECT_TRUE((b.Transpose() * a.Transpose()).EqMatrix(product.Transpose()));
+
+  s21_set_num_threads(threads);
+}
+
+TEST(S21ParallelTest, CustomExecutor) {
+  CountingExecutor executor;
+  s21_set_executor(&executor);
+  EXPECT_EQ(s21_get_num_threads(), 3);
+
+  S21Matrix a = Filled(400, 400, 4);
+  S21Matrix b = a;
+  b.SumMatrix(a);
+  s21_set_executor(nullptr);
+
+  EXPECT_GT(executor.calls_, 0);
+  EXPECT_TRUE(b.EqMatrix(a * 2));
+}
+
+TEST(S21AllocatorTest, Pool) {
+  S21PoolAllocator& pool = S21PoolAllocator::Instance();
+  pool.Trim();
+
+  const double* buffer;
+  {
+    S21Matrix mat(10, 10, pool);
+    EXPECT_EQ(&mat.getAllocator(), &pool);
+    buffer = &mat(0, 0);
+  }
+
+  S21Matrix mat(9, 12, pool);
+  EXPECT_EQ(&mat(0, 0), buffer);
+  EXPECT_DOUBLE_EQ(mat(8, 11), 0);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(buffer) % 64, 0u);
+
+  std::vector<void*> blocks;
+  for (std::size_t i = 0; i < S21PoolAllocator::kThreadCacheBlocks + 4; ++i) {
+    blocks.push_back(pool.Allocate(1000));
+  }
+  for (void* block : blocks) {
+    pool.Deallocate(block, 1000);
+  }
+  EXPECT_EQ(pool.getCachedBlocks(), 4u);
+
+  void* large = pool.Allocate(S21PoolAllocator::kMaxPooledBytes + 1);
+  pool.Deallocate(large, S21PoolAllocator::kMaxPooledBytes + 1);
+
+  pool.Trim();
+  EXPECT_EQ(pool.getCachedBlocks(), 0u);
+}
+
+TEST(S21AllocatorTest, ArenaScope) {
+  S21Arena arena(4096);
+  S21Matrix kept = Filled(3, 3, 1);
+  const double expected = Filled(8, 8, 1)(7, 7) + 2 * Filled(8, 8, 2)(7, 7);
+
+  {
+    S21AllocatorScope scope(arena);
+    EXPECT_EQ(&s21_get_allocator(), &arena);
+
+    S21Matrix a = Filled(8, 8, 1);
+    S21Matrix b = Filled(8, 8, 2);
+    S21Matrix c = a + b * 2.0;
+    EXPECT_EQ(&c.getAllocator(), &arena);
+    EXPECT_GT(arena.getUsed(), 0u);
+
+    S21Matrix big(100, 100);
+    EXPECT_GE(arena.getCapacity(), 100u * 104u * sizeof(double));
+
+    kept = c;
+    EXPECT_EQ(&kept.getAllocator(), &S21HeapAllocator::Instance());
+  }
+
+  EXPECT_EQ(&s21_get_allocator(), &S21HeapAllocator::Instance());
+  EXPECT_EQ(arena.getUsed(), 0u);
+  EXPECT_DOUBLE_EQ(kept(7, 7), expected);
+}
+
+TEST(S21AllocatorTest, ArenaLifo) {
+  S21Arena arena(1024);
+  void* a = arena.Allocate(100);
+  void* b = arena.Allocate(200);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(b) % 64, 0u);
+  const std::size_t used = arena.getUsed();
+
+  arena.Deallocate(b, 200);
+  EXPECT_LT(arena.getUsed(), used);
+  EXPECT_EQ(arena.Allocate(200), b);
+
+  arena.Deallocate(a, 100);
+  EXPECT_EQ(arena.getUsed(), used);
+
+  arena.Reset();
+  EXPECT_EQ(arena.Allocate(100), a);
+}
+
+TEST(S21AllocatorTest, ThreadLocal) {
+  S21Arena arena;
+  S21AllocatorScope scope(arena);
+
+  S21Allocator* other = nullptr;
+  std::thread thread([&] { other = &s21_get_allocator(); });
+  thread.join();
+
+  EXPECT_EQ(other, &S21HeapAllocator::Instance());
+  EXPECT_EQ(&s21_get_allocator(), &arena);
+}
+
+TEST(S21FixedMatrixTest, Constexpr) {
+  constexpr S21Matrix3 a(2.0, 5.0, 7.0, 6.0, 3.0, 4.0, 5.0, -2.0, -3.0);
+  static_assert(a.Determinant() == -1, "");
+  static_assert(a.Transpose()(0, 1) == 6, "");
+  static_assert((a * S21Matrix3::Identity()).EqMatrix(a), "");
+  static_assert((a + a - a * 2.0) == S21Matrix3(), "");
+  static_assert((2 * a) == (a * 2), "");
+  static_assert((2 * S21FixedMatrix<1, 1, float>(1.5f))(0, 0) == 3, "");
+
+  constexpr S21Matrix3 inverse = a.InverseMatrix();
+  static_assert((a * inverse) == S21Matrix3::Identity(), "");
+  static_assert(inverse(0, 0) == 1 && inverse(2, 2) == 24, "");
+
+  constexpr S21FixedMatrix<2, 3> b(1, 2, 3, 4, 5, 6);
+  constexpr S21FixedMatrix<2, 2> c = b * b.Transpose();
+  static_assert(c(0, 0) == 14 && c(0, 1) == 32 && c(1, 1) == 77, "");
+  static_assert(S21FixedMatrix<2, 3>::getCols() == 3, "");
+}
+
+TEST(S21FixedMatrixTest, Operations) {
+  S21Matrix4 a(4.0, 1.0, 0.0, 2.0, 1.0, 5.0, 1.0, 0.0, 0.0, 1.0, 6.0, 1.0,
+               2.0, 0.0, 1.0, 7.0);
+  S21Matrix dynamic = static_cast<S21Matrix>(a);
+
+  EXPECT_NEAR(a.Determinant(), dynamic.Determinant(), 1e-9);
+  EXPECT_TRUE(static_cast<S21Matrix>(a.InverseMatrix())
+                  .EqMatrix(dynamic.InverseMatrix()));
+  EXPECT_TRUE(static_cast<S21Matrix>(a.CalcComplements())
+                  .EqMatrix(dynamic.CalcComplements()));
+  EXPECT_TRUE(static_cast<S21Matrix>(a.Minor(1, 2))
+                  .EqMatrix(dynamic.Minor(1, 2)));
+
+  S21Matrix4 b(dynamic);
+  b *= a;
+  b += a;
+  b -= 2.0 * a;
+  EXPECT_TRUE(static_cast<S21Matrix>(b).EqMatrix(dynamic * dynamic - dynamic));
+
+  EXPECT_THROW(S21Matrix4 bad(S21Matrix(3, 4)), std::invalid_argument);
+  EXPECT_THROW(a(4, 0), std::out_of_range);
+  EXPECT_THROW(a.Minor(0, 4), std::out_of_range);
+  EXPECT_THROW(S21Matrix3().InverseMatrix(), std::domain_error);
+}
+
+TEST(S21FixedMatrixTest, Large) {
+  S21FixedMatrix<6, 6> a;
+  for (int i = 0; i < 6; ++i) {
+    for (int j = 0; j < 6; ++j) {
+      a(i, j) = (i == j) ? 10 : ((i * 7 + j * 3) % 5) - 2;
+    }
+  }
+  S21Matrix dynamic = static_cast<S21Matrix>(a);
+
+  EXPECT_NEAR(a.Determinant(), dynamic.Determinant(),
+              1e-9 * std::fabs(dynamic.Determinant()));
+  EXPECT_TRUE((a * a.InverseMatrix()) == (S21FixedMatrix<6, 6>::Identity()));
+  EXPECT_THROW((S21FixedMatrix<5, 5>().InverseMatrix()), std::domain_error);
+
+  S21FixedMatrix<2, 2, float> f(1.0f, 2.0f, 3.0f, 4.0f);
+  EXPECT_FLOAT_EQ(f.Determinant(), -2.0f);
+}
+
+TEST(S21FixedMatrixTest, ScaledInverse) {
+  // One singularity rule for every size, the S21LU one.
+  const S21Matrix3 small = S21Matrix3::Identity() * 1e-3;
+  EXPECT_TRUE((small * small.InverseMatrix()) == S21Matrix3::Identity());
+
+  S21FixedMatrix<2, 2> a2;
+  S21FixedMatrix<5, 5> a5;
+  a2(0, 0) = a5(0, 0) = 1e-7;
+  a2(1, 1) = 1e8;
+  for (int i = 1; i < 5; ++i) {
+    a5(i, i) = 1e8;
+  }
+  EXPECT_NEAR(a2.InverseMatrix()(0, 0), 1e7, 1e-3);
+  EXPECT_NEAR(a5.InverseMatrix()(0, 0), 1e7, 1e-3);
+  EXPECT_NEAR(a5.InverseMatrix()(4, 4), 1e-8, 1e-20);
+
+  a2(0, 0) = a2(0, 1) = a2(1, 0) = 1e8;
+  a2(1, 1) = 1e8 + 1e-4;
+  EXPECT_THROW(a2.InverseMatrix(), std::domain_error);
+  EXPECT_THROW(static_cast<S21Matrix>(a2).InverseMatrix(), std::domain_error);
+}
+
+TEST(S21MatrixViewTest, Block) {
+  S21Matrix a = Filled(6, 7, 1);
+  S21MatrixView block = a.Block(1, 2, 3, 4);
+  EXPECT_EQ(block.getRows(), 3);
+  EXPECT_EQ(block.getCols(), 4);
+  EXPECT_TRUE(block.isContiguous());
+  EXPECT_DOUBLE_EQ(block(2, 3), a(3, 5));
+  EXPECT_THROW(block(3, 0), std::out_of_range);
+  EXPECT_THROW(a.Block(4, 0, 3, 1), std::out_of_range);
+  EXPECT_THROW(a.Block(0, 0, 1, 0), std::out_of_range);
+
+  S21Matrix b = Filled(3, 4, 2);
+  S21Matrix expected(b);
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      expected(i, j) += a(i + 1, j + 2);
+    }
+  }
+  b.SumMatrix(block);
+  EXPECT_TRUE(b.EqMatrix(expected));
+  b.SubMatrix(block);
+  EXPECT_TRUE(b.EqMatrix(Filled(3, 4, 2)));
+  EXPECT_THROW(b.SumMatrix(a.Block(0, 0, 2, 2)), std::invalid_argument);
+
+  S21Matrix copy = block;
+  EXPECT_TRUE(copy.EqMatrix(block));
+}
+
+TEST(S21MatrixViewTest, MinorAndTranspose) {
+  S21Matrix a = Filled(5, 4, 1);
+
+  S21MatrixView minor = a.MinorView(2, 1);
+  EXPECT_FALSE(minor.isContiguous());
+  EXPECT_TRUE(a.Minor(2, 1).EqMatrix(minor));
+  EXPECT_DOUBLE_EQ(minor(2, 1), a(3, 2));
+
+  S21MatrixView transposed = a.TransposeView();
+  EXPECT_EQ(transposed.getRows(), 4);
+  EXPECT_TRUE(a.Transpose().EqMatrix(transposed));
+  EXPECT_TRUE(S21Matrix(minor.Transpose()).EqMatrix(a.Minor(2, 1).Transpose()));
+
+  S21Matrix b = Filled(3, 4, 2);
+  S21Matrix expected = b * a.Transpose();
+  b.MulMatrix(transposed);
+  EXPECT_TRUE(b.EqMatrix(expected));
+  EXPECT_THROW(b.MulMatrix(minor), std::domain_error);
+}
+
+TEST(S21MatrixViewTest, Aliasing) {
+  S21Matrix a = Filled(4, 4, 1);
+  S21Matrix expected = a.Transpose();
+
+  a = a.TransposeView();
+  EXPECT_TRUE(a.EqMatrix(expected));
+
+  expected = a + a.Transpose();
+  a.SumMatrix(a.TransposeView());
+  EXPECT_TRUE(a.EqMatrix(expected));
+
+  S21Matrix c = Filled(4, 4, 3);
+  expected = c.Minor(0, 0);
+  c = c.MinorView(0, 0);
+  EXPECT_EQ(c.getRows(), 3);
+  EXPECT_TRUE(c.EqMatrix(expected));
+}
+
+static double NormInf(const S21Matrix& mat) {
+  double norm = 0;
+  for (int i = 0; i < mat.getRows(); ++i) {
+    double sum = 0;
+    for (int j = 0; j < mat.getCols(); ++j) {
+      sum += std::fabs(mat(i, j));
+    }
+    norm = std::max(norm, sum);
+  }
+  return norm;
+}
+
+TEST(S21StrassenTest, MatchesClassical) {
+  const int m = 135, k = 101, n = 77, cutoff = 16;
+  S21Matrix a = Filled(m, k, 1);
+  S21Matrix b = Filled(k, n, 2);
+  S21Matrix expected = a * b;
+
+  S21Matrix c(m, n);
+  s21_gemm_strassen(m, n, k, &a(0, 0), a.getStride(), &b(0, 0),
+                    b.getStride(), &c(0, 0), c.getStride(), cutoff);
+
+  // Documented bound: three levels of recursion above leaves of size <= 16.
+  const double n0 = 16, levels = 3;
+  const double bound = std::pow(18, levels) * (n0 * n0 + 5 * n0) *
+                       std::ldexp(1.0, -53) * NormInf(a) * NormInf(b);
+
+  double error = 0;
+  for (int i = 0; i < m; ++i) {
+    for (int j = 0; j < n; ++j) {
+      error = std::max(error, std::fabs(c(i, j) - expected(i, j)));
+    }
+  }
+  EXPECT_LE(error, bound);
+  EXPECT_TRUE(c.EqMatrix(expected));
+}
+
+TEST(S21StrassenTest, Threshold) {
+  S21Matrix a = Filled(150, 150, 3);
+  S21Matrix b = Filled(150, 150, 4);
+  S21Matrix expected = a * b;
+
+  EXPECT_EQ(s21_get_strassen_threshold(), 0);
+  s21_set_strassen_threshold(64);
+  EXPECT_EQ(s21_get_strassen_threshold(), 64);
+  S21Matrix c = a * b;
+  s21_set_strassen_threshold(0);
+
+  EXPECT_TRUE(c.EqMatrix(expected));
+}
+
+static S21Matrix Sparse(const int rows, const int cols, const int seed) {
+  S21Matrix mat(rows, cols);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      if ((i * 7 + j * 3 + seed) % 5 == 0) {
+        mat(i, j) = (i + 1) * 0.5 - j;
+      }
+    }
+  }
+  return mat;
+}
+
+TEST(S21SparseTest, DenseRoundTrip) {
+  S21Matrix dense = Sparse(17, 13, 1);
+  dense(0, 0) = 1e-9;
+  S21SparseMatrix sparse(dense);
+
+  EXPECT_EQ(sparse.getRows(), 17);
+  EXPECT_EQ(sparse.getCols(), 13);
+  EXPECT_EQ(sparse.getRowPtr().back(), sparse.getNonZeros());
+  EXPECT_LT(sparse.getNonZeros(), 17 * 13 / 4);
+  EXPECT_TRUE(sparse.ToDense() == dense);
+  EXPECT_DOUBLE_EQ(sparse(0, 0), 0);
+  EXPECT_DOUBLE_EQ(sparse(3, 2), dense(3, 2));
+  EXPECT_THROW(sparse(17, 0), std::out_of_range);
+}
+
+TEST(S21SparseTest, Builder) {
+  S21SparseBuilder builder(3, 4);
+  builder.Add(2, 3, 1.5);
+  builder.Add(0, 1, 2);
+  builder.Add(2, 3, 0.5);
+  builder.Add(1, 0, 1);
+  builder.Add(1, 0, -1);
+  S21SparseMatrix sparse = builder.Build();
+
+  EXPECT_EQ(sparse.getNonZeros(), 2);
+  EXPECT_EQ(sparse.getRowPtr(), std::vector<int>({0, 1, 1, 2}));
+  EXPECT_DOUBLE_EQ(sparse(2, 3), 2);
+  EXPECT_DOUBLE_EQ(sparse(0, 1), 2);
+  EXPECT_DOUBLE_EQ(sparse(1, 0), 0);
+  EXPECT_THROW(builder.Add(3, 0, 1), std::out_of_range);
+  EXPECT_THROW(S21SparseBuilder(0, 1), std::invalid_argument);
+}
+
+TEST(S21SparseTest, Arithmetic) {
+  S21Matrix a = Sparse(9, 11, 1);
+  S21Matrix b = Sparse(9, 11, 3);
+  S21SparseMatrix sa(a), sb(b);
+
+  EXPECT_TRUE((sa + sb).ToDense() == a + b);
+  EXPECT_TRUE((sa - sb).ToDense() == a - b);
+  EXPECT_TRUE((sa * 2.5).ToDense() == a * 2.5);
+  EXPECT_EQ((sa - sa).getNonZeros(), 0);
+  EXPECT_TRUE(sa.Transpose().ToDense() == a.Transpose());
+  EXPECT_TRUE(sa.Transpose().Transpose() == sa);
+  EXPECT_FALSE(sa == sb);
+  EXPECT_THROW(sa + S21SparseMatrix(9, 10), std::invalid_argument);
+
+  // Entries only one side stores are kept, however small.
+  S21SparseMatrix tiny(a * 1e-9, 0);
+  S21SparseMatrix sum = tiny + S21SparseMatrix(9, 11);
+  EXPECT_EQ(sum.getNonZeros(), sa.getNonZeros());
+  EXPECT_EQ(sum.getValues(), tiny.getValues());
+  EXPECT_EQ((S21SparseMatrix(9, 11) - tiny).getNonZeros(), sa.getNonZeros());
+  EXPECT_EQ((tiny - tiny).getNonZeros(), 0);
+}
+
+TEST(S21SparseTest, Multiply) {
+  S21Matrix a = Sparse(40, 30, 2);
+  S21Matrix b = Filled(30, 25, 4);
+  S21SparseMatrix sa(a);
+
+  EXPECT_TRUE(sa * b == a * b);
+
+  std::vector<double> x(30);
+  for (int j = 0; j < 30; ++j) {
+    x[j] = j * 0.25 - 3;
+  }
+  std::vector<double> y = sa * x;
+  ASSERT_EQ(y.size(), 40u);
+  for (int i = 0; i < 40; ++i) {
+    double expected = 0;
+    for (int j = 0; j < 30; ++j) {
+      expected += a(i, j) * x[j];
+    }
+    EXPECT_NEAR(y[i], expected, 1e-9);
+  }
+
+  EXPECT_THROW(sa * Filled(29, 2, 0), std::domain_error);
+  EXPECT_THROW(sa * std::vector<double>(29), std::domain_error);
+}
+
+static S21MatrixBatch FilledBatch(const int count, const int n,
+                                  const int seed) {
+  S21MatrixBatch batch(count, n, n);
+  for (int b = 0; b < count; ++b) {
+    S21Matrix mat = Filled(n, n, seed + b);
+    for (int i = 0; i < n; ++i) {
+      mat(i, i) += (b % 3) - 1;
+    }
+    batch.Set(b, mat);
+  }
+  return batch;
+}
+
+TEST(S21BatchTest, Determinant) {
+  for (int n : {1, 3, 4, 6}) {
+    S21MatrixBatch batch = FilledBatch(1001, n, n);
+    std::vector<double> det = batch.BatchDeterminant();
+    ASSERT_EQ(det.size(), 1001u);
+    for (int b = 0; b < 1001; b += 7) {
+      const double expected = batch.Get(b).Determinant();
+      EXPECT_NEAR(det[b], expected, 1e-9 * (1 + fabs(expected)));
+    }
+  }
+  EXPECT_THROW(S21MatrixBatch(4, 2, 3).BatchDeterminant(), std::domain_error);
+}
+
+TEST(S21BatchTest, Inverse) {
+  for (int n : {2, 3, 4, 6}) {
+    S21MatrixBatch batch(517, n, n);
+    for (int b = 0; b < 517; ++b) {
+      S21Matrix mat = Filled(n, n, b);
+      for (int i = 0; i < n; ++i) {
+        mat(i, i) += n;
+      }
+      batch.Set(b, mat);
+    }
+    S21MatrixBatch inverse = batch.BatchInverse();
+    for (int b = 0; b < 517; b += 11) {
+      EXPECT_TRUE(inverse.Get(b) == batch.Get(b).InverseMatrix());
+    }
+  }
+
+  S21MatrixBatch singular(9, 2, 2);
+  for (int b = 0; b < 9; ++b) {
+    singular(b, 0, 0) = singular(b, 1, 1) = 1;
+  }
+  singular(5, 1, 1) = 0;
+  EXPECT_THROW(singular.BatchInverse(), std::domain_error);
+
+  // Badly scaled columns are as regular here as for S21LU.
+  S21MatrixBatch scaled(9, 3, 3);
+  for (int b = 0; b < 9; ++b) {
+    S21Matrix mat = Filled(3, 3, b);
+    for (int i = 0; i < 3; ++i) {
+      mat(i, i) += 3;
+      mat(i, 0) *= 1e-7;
+      mat(i, 2) *= 1e8;
+    }
+    scaled.Set(b, mat);
+  }
+  S21MatrixBatch scaled_inverse = scaled.BatchInverse();
+  for (int b = 0; b < 9; ++b) {
+    EXPECT_TRUE(scaled_inverse.Get(b) == scaled.Get(b).InverseMatrix());
+  }
+}
+
+TEST(S21BatchTest, Mul) {
+  S21MatrixBatch a(300, 3, 5), b(300, 5, 2);
+  for (int k = 0; k < 300; ++k) {
+    a.Set(k, Filled(3, 5, k));
+    b.Set(k, Filled(5, 2, 2 * k));
+  }
+  S21MatrixBatch c = a.BatchMul(b);
+  EXPECT_EQ(c.getCount(), 300);
+  EXPECT_EQ(c.getRows(), 3);
+  EXPECT_EQ(c.getCols(), 2);
+  for (int k = 0; k < 300; k += 13) {
+    EXPECT_TRUE(c.Get(k) == a.Get(k) * b.Get(k));
+  }
+  EXPECT_THROW(a.BatchMul(a), std::domain_error);
+  EXPECT_THROW(a.BatchMul(S21MatrixBatch(299, 5, 2)), std::domain_error);
+}
+
+TEST(S21BatchTest, Access) {
+  S21MatrixBatch batch(3, 2, 2);
+  batch(2, 1, 0) = 4;
+  S21MatrixBatch copy(batch);
+  S21MatrixBatch moved(std::move(batch));
+  EXPECT_DOUBLE_EQ(copy(2, 1, 0), 4);
+  EXPECT_DOUBLE_EQ(moved.Get(2)(1, 0), 4);
+  copy = moved;
+  EXPECT_DOUBLE_EQ(copy(2, 1, 0), 4);
+  EXPECT_THROW(copy(3, 0, 0), std::out_of_range);
+  EXPECT_THROW(copy.Set(0, S21Matrix(3, 2)), std::invalid_argument);
+  EXPECT_THROW(S21MatrixBatch(0, 1, 1), std::invalid_argument);
+}
+
+TEST(S21BatchTest, Parallel) {
+  S21ThreadPool pool(4);
+  s21_set_executor(&pool);
+  S21MatrixBatch batch = FilledBatch(20000, 4, 1);
+  std::vector<double> det = batch.BatchDeterminant();
+  s21_set_executor(nullptr);
+  for (int b = 0; b < 20000; b += 997) {
+    const double expected = batch.Get(b).Determinant();
+    EXPECT_NEAR(det[b], expected, 1e-9 * (1 + fabs(expected)));
+  }
+}
+
+static std::vector<char> ReadBytes(const char* path) {
+  std::ifstream file(path, std::ios::binary);
+  return std::vector<char>(std::istreambuf_iterator<char>(file),
+                           std::istreambuf_iterator<char>());
+}
+
+static void WriteBytes(const char* path, const std::vector<char>& bytes) {
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+TEST(S21MatrixIOTest, SaveLoad) {
+  const char* path = "s21_io_test.bin";
+  S21Matrix mat = Filled(37, 21, 5);
+  mat(3, 4) = 1.0 / 3;
+  mat.Save(path);
+
+  EXPECT_EQ(ReadBytes(path).size(),
+            sizeof(S21MatrixFileHeader) + sizeof(double) * 37 * 24);
+
+  S21Matrix loaded = S21Matrix::Load(path);
+  EXPECT_EQ(loaded.getRows(), 37);
+  EXPECT_EQ(loaded.getCols(), 21);
+  EXPECT_EQ(loaded(3, 4), 1.0 / 3);
+  EXPECT_TRUE(loaded == mat);
+
+  std::remove(path);
+  EXPECT_THROW(S21Matrix::Load(path), std::runtime_error);
+}
+
+TEST(S21MatrixIOTest, MapFile) {
+  const char* path = "s21_io_test.bin";
+  S21Matrix mat = Filled(50, 9, 2);
+  mat.Save(path);
+
+  S21MappedMatrix mapped = S21MappedMatrix::MapFile(path, true);
+  EXPECT_EQ(mapped.getRows(), 50);
+  EXPECT_EQ(mapped.getCols(), 9);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(mapped.getData()) %
+                S21Allocator::kAlignment,
+            0u);
+  EXPECT_DOUBLE_EQ(mapped(49, 8), mat(49, 8));
+  EXPECT_THROW(mapped(50, 0), std::out_of_range);
+  EXPECT_TRUE(mat.EqMatrix(mapped.View()));
+
+  S21Matrix sum = mat + mapped.View();
+  EXPECT_TRUE(sum == mat * 2);
+
+  S21MappedMatrix moved(std::move(mapped));
+  EXPECT_TRUE(S21Matrix(moved.View()) == mat);
+  std::remove(path);
+}
+
+TEST(S21MatrixIOTest, Corruption) {
+  const char* path = "s21_io_test.bin";
+  Filled(8, 8, 1).Save(path);
+  std::vector<char> bytes = ReadBytes(path);
+
+  std::vector<char> damaged = bytes;
+  damaged[sizeof(S21MatrixFileHeader) + 13] ^= 1;
+  WriteBytes(path, damaged);
+  EXPECT_THROW(S21Matrix::Load(path), std::runtime_error);
+  EXPECT_NO_THROW(S21MappedMatrix::MapFile(path));
+  EXPECT_THROW(S21MappedMatrix::MapFile(path, true), std::runtime_error);
+
+  damaged = bytes;
+  damaged[0] = 'X';
+  WriteBytes(path, damaged);
+  EXPECT_THROW(S21Matrix::Load(path), std::runtime_error);
+  EXPECT_THROW(S21MappedMatrix::MapFile(path), std::runtime_error);
+
+  damaged.assign(bytes.begin(), bytes.end() - 64);
+  WriteBytes(path, damaged);
+  EXPECT_THROW(S21Matrix::Load(path), std::runtime_error);
+  EXPECT_THROW(S21MappedMatrix::MapFile(path), std::runtime_error);
+  std::remove(path);
+}
+
+TEST(S21MatrixIOTest, CorruptHeader) {
+  const char* path = "s21_io_test.bin";
+  Filled(2, 2, 1).Save(path);
+  std::vector<char> bytes = ReadBytes(path);
+  S21MatrixFileHeader header;
+  std::memcpy(&header, bytes.data(), sizeof(header));
+
+  // Each patch leaves the magic and version intact.
+  auto patched = [&](auto patch) {
+    S21MatrixFileHeader damaged = header;
+    patch(damaged);
+    std::vector<char> file = bytes;
+    std::memcpy(file.data(), &damaged, sizeof(damaged));
+    WriteBytes(path, file);
+  };
+
+  patched([](S21MatrixFileHeader& h) { h.header_size = 1u << 24; });
+  EXPECT_THROW(S21Matrix::Load(path), std::runtime_error);
+  EXPECT_THROW(S21MappedMatrix::MapFile(path), std::runtime_error);
+  EXPECT_THROW(S21MappedMatrix::MapFile(path, true), std::runtime_error);
+
+  patched([](S21MatrixFileHeader& h) { h.rows = 1000; });
+  EXPECT_THROW(S21MappedMatrix::MapFile(path), std::runtime_error);
+  patched([](S21MatrixFileHeader& h) { h.cols = h.stride + 1; });
+  EXPECT_THROW(S21MappedMatrix::MapFile(path), std::runtime_error);
+  patched([](S21MatrixFileHeader& h) { h.stride *= 2; });
+  EXPECT_THROW(S21MappedMatrix::MapFile(path), std::runtime_error);
+  patched([](S21MatrixFileHeader& h) { h.payload_bytes *= 2; });
+  EXPECT_THROW(S21MappedMatrix::MapFile(path), std::runtime_error);
+
+  patched([](S21MatrixFileHeader&) {});
+  EXPECT_NO_THROW(S21MappedMatrix::MapFile(path, true));
+  std::remove(path);
+}
+
+// Rewrites a saved file the way a machine of the opposite byte order would
+// have written it: header fields and elements swapped, checksum recomputed
+// over the new payload bytes.
+static void SwapByteOrder(const char* path, const std::size_t element) {
+  std::vector<char> bytes = ReadBytes(path);
+  auto swap = [&](std::size_t offset, std::size_t size) {
+    std::reverse(bytes.begin() + offset, bytes.begin() + offset + size);
+  };
+  for (std::size_t offset : {8, 12, 20, 24, 28}) {
+    swap(offset, 4);
+  }
+  swap(18, 2);
+  swap(32, 8);
+  bytes[17] = bytes[17] == S21MatrixFileHeader::kLittleEndian
+                  ? S21MatrixFileHeader::kBigEndian
+                  : S21MatrixFileHeader::kLittleEndian;
+  for (std::size_t offset = 64; offset < bytes.size(); offset += element) {
+    swap(offset, element);
+  }
+  const std::uint64_t checksum =
+      s21_checksum(bytes.data() + 64, bytes.size() - 64);
+  std::memcpy(bytes.data() + 40, &checksum, sizeof(checksum));
+  swap(40, 8);
+  WriteBytes(path, bytes);
+}
+
+TEST(S21MatrixIOTest, ForeignByteOrder) {
+  const char* path = "s21_io_test.bin";
+  S21Matrix mat = Filled(3, 5, 7);
+  mat.Save(path);
+  SwapByteOrder(path, sizeof(double));
+
+  EXPECT_TRUE(S21Matrix::Load(path) == mat);
+  EXPECT_THROW(S21MappedMatrix::MapFile(path), std::runtime_error);
+
+  // Two floats share each checksum word, in an order that depends on the
+  // byte order; the checksum covers the stored bytes, so it still holds.
+  S21MatrixF floats(Filled(5, 3, 2));
+  floats.Save(path);
+  SwapByteOrder(path, sizeof(float));
+  EXPECT_TRUE(S21MatrixF::Load(path) == floats);
+  std::remove(path);
+}
+
+TEST(S21OutOfCoreTest, MultiplyFiles) {
+  S21Matrix a = Filled(150, 70, 1);
+  S21Matrix b = Filled(70, 130, 2);
+  a.Save("s21_ooc_a.bin");
+  b.Save("s21_ooc_b.bin");
+  S21Matrix expected = a * b;
+
+  S21OutOfCoreStats stats =
+      s21_multiply_files("s21_ooc_a.bin", "s21_ooc_b.bin", "s21_ooc_c.bin");
+  EXPECT_EQ(stats.tile_rows, 150);
+  EXPECT_EQ(stats.tile_cols, 130);
+  EXPECT_TRUE(S21Matrix::Load("s21_ooc_c.bin") == expected);
+
+  // A 64 KB budget forces narrow tiles written out of order.
+  stats = s21_multiply_files("s21_ooc_a.bin", "s21_ooc_b.bin",
+                             "s21_ooc_c.bin", 64 * 1024);
+  EXPECT_LT(stats.tile_cols, 130);
+  EXPECT_LE(stats.buffer_bytes, 64u * 1024);
+  EXPECT_GT(stats.bytes_read, sizeof(double) * (150 * 70 + 70 * 130));
+  EXPECT_TRUE(S21Matrix::Load("s21_ooc_c.bin") == expected);
+
+  stats = s21_multiply_files("s21_ooc_a.bin", "s21_ooc_b.bin",
+                             "s21_ooc_c.bin", 4 * 1024);
+  EXPECT_LE(stats.buffer_bytes, 4u * 1024);
+  EXPECT_TRUE(S21Matrix::Load("s21_ooc_c.bin") == expected);
+
+  EXPECT_THROW(s21_multiply_files("s21_ooc_a.bin", "s21_ooc_b.bin",
+                                  "s21_ooc_c.bin", 64),
+               std::invalid_argument);
+  EXPECT_THROW(s21_multiply_files("s21_ooc_a.bin", "s21_ooc_a.bin",
+                                  "s21_ooc_c.bin"),
+               std::domain_error);
+  EXPECT_THROW(s21_multiply_files("s21_ooc_a.bin", "s21_ooc_missing.bin",
+                                  "s21_ooc_c.bin"),
+               std::runtime_error);
+
+  std::remove("s21_ooc_a.bin");
+  std::remove("s21_ooc_b.bin");
+  std::remove("s21_ooc_c.bin");
+}
+
+TEST(S21StatsTest, Counters) {
+  S21StatsScope scope;
+  S21Matrix a = Filled(10, 10, 1);
+  S21Matrix b = Filled(10, 10, 2);
+  a.MulMatrix(b);
+  a.Determinant();
+  a.SumMatrix(b);
+  S21StatsSnapshot stats = scope.Elapsed();
+
+  if (s21_stats_enabled()) {
+    EXPECT_EQ(stats[S21Op::kMulMatrix].calls, 1u);
+    EXPECT_EQ(stats[S21Op::kMulMatrix].flops, 2000u);
+    EXPECT_EQ(stats[S21Op::kDeterminant].calls, 1u);
+    EXPECT_EQ(stats[S21Op::kSumMatrix].flops, 100u);
+    EXPECT_EQ(stats[S21Op::kInverseMatrix].calls, 0u);
+    EXPECT_GE(stats.alloc_count, 3u);
+    EXPECT_GE(stats.alloc_bytes, 3 * sizeof(double) * 10 * 16);
+  } else {
+    EXPECT_EQ(stats[S21Op::kMulMatrix].calls, 0u);
+    EXPECT_EQ(stats.alloc_count, 0u);
+  }
+}
+
+TEST(S21StatsTest, Threads) {
+  s21_stats_reset();
+  S21StatsScope scope;
+  std::thread worker([] {
+    S21Matrix a = Filled(4, 4, 1);
+    a.InverseMatrix();
+  });
+  worker.join();
+
+  EXPECT_EQ(scope.Elapsed()[S21Op::kInverseMatrix].calls, 0u);
+  EXPECT_EQ(s21_stats_snapshot()[S21Op::kInverseMatrix].calls,
+            s21_stats_enabled() ? 1u : 0u);
+
+  s21_stats_reset();
+  EXPECT_EQ(s21_stats_snapshot()[S21Op::kInverseMatrix].calls, 0u);
+}
+
+TEST(S21StatsTest, Prometheus) {
+  S21StatsSnapshot snapshot;
+  snapshot.ops[static_cast<int>(S21Op::kMulMatrix)].calls = 3;
+  snapshot.ops[static_cast<int>(S21Op::kMulMatrix)].nanoseconds = 1500000000;
+  snapshot.alloc_bytes = 4096;
+  const std::string text = s21_stats_prometheus(snapshot);
+
+  EXPECT_NE(text.find("# TYPE s21_matrix_calls_total counter\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("s21_matrix_calls_total{op=\"MulMatrix\"} 3\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("s21_matrix_seconds_total{op=\"MulMatrix\"} 1.5"),
+            std::string::npos);
+  EXPECT_NE(text.find("s21_matrix_alloc_bytes_total 4096\n"),
+            std::string::npos);
+  EXPECT_STREQ(s21_op_name(S21Op::kCalcComplements), "CalcComplements");
+}
+
+TEST(S21MatrixTest, UncheckedAccess) {
+  S21Matrix mat = Filled(5, 3, 1);
+  const S21Matrix& view = mat;
+
+  EXPECT_EQ(mat.data(), mat.row(0));
+  EXPECT_EQ(mat.row(2), mat.data() + 2 * mat.getStride());
+  EXPECT_EQ(mat[4], view.row(4));
+  EXPECT_DOUBLE_EQ(mat.at_unchecked(3, 2), mat(3, 2));
+  EXPECT_DOUBLE_EQ(view.at_unchecked(1, 0), mat(1, 0));
+
+  mat[1][2] = 7;
+  mat.at_unchecked(0, 1) = 8;
+  mat.row(4)[0] = 9;
+  EXPECT_DOUBLE_EQ(mat(1, 2), 7);
+  EXPECT_DOUBLE_EQ(view[0][1], 8);
+  EXPECT_DOUBLE_EQ(mat(4, 0), 9);
+
+  EXPECT_DEBUG_DEATH(mat.at_unchecked(5, 0), "");
+  EXPECT_DEBUG_DEATH(mat.at_unchecked(0, 3), "");
+}
+
+TEST(S21MatrixTest, Iterators) {
+  S21Matrix mat(3, 3);
+  EXPECT_EQ(std::distance(mat.begin(), mat.end()), 9);
+
+  double value = 0;
+  for (double& element : mat) {
+    element = ++value;
+  }
+  EXPECT_DOUBLE_EQ(mat(2, 0), 7);
+  EXPECT_DOUBLE_EQ(std::accumulate(mat.cbegin(), mat.cend(), 0.0), 45);
+
+  S21Matrix::iterator it = mat.begin() + 5;
+  EXPECT_DOUBLE_EQ(*it, 6);
+  EXPECT_DOUBLE_EQ(*(it - 4), 2);
+  EXPECT_DOUBLE_EQ(it[2], 8);
+  EXPECT_EQ(it - mat.begin(), 5);
+  EXPECT_EQ(mat.end() - it, 4);
+  EXPECT_TRUE(mat.begin() < it);
+  --it;
+  EXPECT_DOUBLE_EQ(*it--, 5);
+  EXPECT_DOUBLE_EQ(*it, 4);
+
+  std::sort(mat.begin(), mat.end(), std::greater<double>());
+  EXPECT_DOUBLE_EQ(mat(0, 0), 9);
+  EXPECT_DOUBLE_EQ(mat(2, 2), 1);
+
+  const S21Matrix& view = mat;
+  S21Matrix::const_iterator cit = mat.begin();
+  EXPECT_TRUE(cit == view.begin());
+  std::vector<double> copy(view.begin(), view.end());
+  EXPECT_EQ(copy.size(), 9u);
+  EXPECT_DOUBLE_EQ(copy[3], 6);
+
+  std::fill(mat.begin(), mat.end(), 1.5);
+  EXPECT_DOUBLE_EQ(mat(1, 1), 1.5);
+  EXPECT_DOUBLE_EQ(mat.data()[3], 0);
+  EXPECT_TRUE(std::all_of(view.begin(), view.end(),
+                          [](double x) { return x == 1.5; }));
+}
+
+template <typename T>
+class S21BasicMatrixTest : public ::testing::Test {
+ protected:
+  // Diagonally dominant, so well conditioned in every element type.
+  static S21BasicMatrix<T> Dominant(const int size) {
+    S21BasicMatrix<T> mat(Filled(size, size, 3));
+    for (int i = 0; i < size; ++i) {
+      mat(i, i) += size;
+    }
+    return mat;
+  }
+};
+
+using S21ElementTypes = ::testing::Types<float, double, long double>;
+TYPED_TEST_SUITE(S21BasicMatrixTest, S21ElementTypes);
+
+TYPED_TEST(S21BasicMatrixTest, Layout) {
+  S21BasicMatrix<TypeParam> mat(3, 5);
+  EXPECT_EQ(mat.getStride() * sizeof(TypeParam) % S21Allocator::kAlignment,
+            0u);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(mat.data()) %
+                S21Allocator::kAlignment,
+            0u);
+  static_assert(std::is_same<decltype(mat(0, 0)), TypeParam&>::value,
+                "element access must use the element type");
+}
+
+TYPED_TEST(S21BasicMatrixTest, MulMatrix) {
+  const S21Matrix a = Filled(70, 90, 1);
+  const S21Matrix b = Filled(90, 60, 2);
+  S21BasicMatrix<TypeParam> product = S21BasicMatrix<TypeParam>(a) *
+                                      S21BasicMatrix<TypeParam>(b);
+  S21Matrix expected = S21Matrix(a) * b;
+
+  ASSERT_EQ(product.getRows(), 70);
+  ASSERT_EQ(product.getCols(), 60);
+  for (int i = 0; i < 70; ++i) {
+    for (int j = 0; j < 60; ++j) {
+      EXPECT_NEAR(static_cast<double>(product(i, j)), expected(i, j),
+                  100 * S21Tolerance<TypeParam>::kEps);
+    }
+  }
+}
+
+TYPED_TEST(S21BasicMatrixTest, DeterminantAndInverse) {
+  S21BasicMatrix<TypeParam> mat(3, 3);
+  const TypeParam values[] = {2, 1, 0, 1, 1, 0, 0, 0, 4};
+  std::copy(values, values + 9, mat.begin());
+  EXPECT_NEAR(mat.Determinant(), 4, S21Tolerance<TypeParam>::kEps);
+
+  S21BasicMatrix<TypeParam> expected(3, 3);
+  const TypeParam inverse[] = {1, -1, 0, -1, 2, 0, 0, 0, 0.25};
+  std::copy(inverse, inverse + 9, expected.begin());
+  EXPECT_TRUE(mat.InverseMatrix().EqMatrix(expected));
+
+  S21BasicMatrix<TypeParam> big = this->Dominant(40);
+  S21BasicMatrix<TypeParam> identity(40, 40);
+  for (int i = 0; i < 40; ++i) {
+    identity(i, i) = 1;
+  }
+  EXPECT_TRUE((big * big.InverseMatrix()).EqMatrix(identity));
+  EXPECT_THROW(S21BasicMatrix<TypeParam>(3, 3).InverseMatrix(),
+               std::domain_error);
+}
+
+TYPED_TEST(S21BasicMatrixTest, CalcComplements) {
+  S21BasicMatrix<TypeParam> mat(3, 3);
+  const TypeParam values[] = {1, 2, 3, 0, 4, 2, 5, 2, 1};
+  std::copy(values, values + 9, mat.begin());
+
+  S21BasicMatrix<TypeParam> expected(3, 3);
+  const TypeParam complements[] = {0, 10, -20, 4, -14, 8, -8, -2, 4};
+  std::copy(complements, complements + 9, expected.begin());
+  EXPECT_TRUE(mat.CalcComplements().EqMatrix(expected));
+}
+
+TYPED_TEST(S21BasicMatrixTest, Tolerance) {
+  const TypeParam eps = S21Tolerance<TypeParam>::kEps;
+  S21BasicMatrix<TypeParam> a(2, 2), b(2, 2);
+  a(1, 1) = 1;
+  b(1, 1) = 1 + eps / 2;
+  EXPECT_TRUE(a == b);
+  b(1, 1) = 1 + 2 * eps;
+  EXPECT_FALSE(a == b);
+}
+
+TYPED_TEST(S21BasicMatrixTest, Expression) {
+  const S21Matrix a = Filled(20, 30, 1);
+  const S21Matrix b = Filled(20, 30, 2);
+  const S21Matrix c = Filled(20, 30, 3);
+  const S21BasicMatrix<TypeParam> ta(a), tb(b), tc(c);
+
+  // Numbers convert to the element type, so 2.0 keeps a float expression.
+  S21BasicMatrix<TypeParam> res = ta + tb * 2.0 - tc;
+  res += ta.TransposeView().Transpose();
+  res = std::move(res) * 0.5;
+  S21Matrix expected = (a + b * 2.0 - c + a) * 0.5;
+  EXPECT_TRUE(res.EqMatrix(S21BasicMatrix<TypeParam>(expected)));
+  using Result = decltype((ta + tb).Eval());
+  static_assert(std::is_same<Result, S21BasicMatrix<TypeParam>>::value,
+                "expressions evaluate to their element type");
+}
+
+TEST(S21MatrixIOTest, SaveLoadFloat) {
+  const char* path = "s21_io_test.bin";
+  S21MatrixF mat(Filled(13, 7, 4));
+  mat(2, 5) = 1.0f / 3;
+  mat.Save(path);
+
+  EXPECT_EQ(ReadBytes(path).size(),
+            sizeof(S21MatrixFileHeader) + sizeof(float) * 13 * 16);
+  EXPECT_EQ(ReadBytes(path)[16], S21MatrixFileHeader::kFloat32);
+
+  S21MatrixF loaded = S21MatrixF::Load(path);
+  EXPECT_EQ(loaded(2, 5), 1.0f / 3);
+  EXPECT_TRUE(loaded == mat);
+  EXPECT_THROW(S21Matrix::Load(path), std::runtime_error);
+  EXPECT_THROW(S21MappedMatrix::MapFile(path), std::runtime_error);
+
+  std::remove(path);
+}
+
+static S21Matrix SymmetricPositiveDefinite(const int size) {
+  S21Matrix m = Filled(size, size, 6);
+  S21Matrix a = m.Transpose() * m;
+  for (int i = 0; i < size; ++i) {
+    a(i, i) += 1;
+  }
+  return a;
+}
+
+TEST(S21SolveTest, General) {
+  S21Matrix a = Filled(50, 50, 1);
+  for (int i = 0; i < 50; ++i) {
+    a(i, i) += 10;
+  }
+  const S21Matrix b = Filled(50, 3, 2);
+
+  S21Matrix x = s21_solve(a, b);
+  EXPECT_TRUE((a * x).EqMatrix(b));
+  EXPECT_TRUE(x.EqMatrix(a.InverseMatrix() * b));
+
+  // Factor once, solve many.
+  const S21LU lu(a);
+  EXPECT_TRUE(lu.Solve(b).EqMatrix(x));
+  S21Matrix c = Filled(50, 7, 3);
+  lu.SolveInPlace(c);
+  EXPECT_TRUE((a * c).EqMatrix(Filled(50, 7, 3)));
+
+  EXPECT_THROW(s21_solve(Filled(3, 4, 1), Filled(3, 1, 1)),
+               std::domain_error);
+  EXPECT_THROW(s21_solve(a, Filled(49, 1, 1)), std::invalid_argument);
+  EXPECT_THROW(s21_solve(S21Matrix(3, 3), Filled(3, 1, 1)),
+               std::domain_error);
+  EXPECT_THROW(lu.SolveInPlace(c = S21Matrix(4, 1)), std::invalid_argument);
+}
+
+TEST(S21SolveTest, Cholesky) {
+  const S21Matrix a = SymmetricPositiveDefinite(40);
+  const S21Matrix b = Filled(40, 2, 4);
+
+  const S21Cholesky cholesky(a);
+  ASSERT_TRUE(cholesky.IsPositiveDefinite());
+  S21Matrix r = cholesky.getR();
+  EXPECT_DOUBLE_EQ(r(5, 2), 0);
+  EXPECT_TRUE((r.Transpose() * r).EqMatrix(a));
+  EXPECT_NEAR(cholesky.Determinant() / S21Matrix(a).Determinant(), 1, 1e-9);
+
+  S21Matrix x = cholesky.Solve(b);
+  EXPECT_TRUE((S21Matrix(a) * x).EqMatrix(b));
+  EXPECT_TRUE(
+      s21_solve(a, b, S21Structure::kSymmetricPositiveDefinite).EqMatrix(x));
+  EXPECT_TRUE(s21_solve(a, b).EqMatrix(x));
+
+  // Symmetric but indefinite: detected as such, solved by LU.
+  S21Matrix indefinite(2, 2);
+  indefinite(0, 0) = 1;
+  indefinite(0, 1) = indefinite(1, 0) = 2;
+  indefinite(1, 1) = 1;
+  EXPECT_FALSE(S21Cholesky(indefinite).IsPositiveDefinite());
+  EXPECT_THROW(S21Cholesky(indefinite).Solve(S21Matrix(2, 1)),
+               std::domain_error);
+  EXPECT_THROW(
+      s21_solve(indefinite, S21Matrix(2, 1),
+                S21Structure::kSymmetricPositiveDefinite),
+      std::domain_error);
+  S21Matrix rhs(2, 1);
+  rhs(0, 0) = 3;
+  rhs(1, 0) = 3;
+  S21Matrix y = s21_solve(indefinite, rhs);
+  EXPECT_NEAR(y(0, 0), 1, 1e-12);
+  EXPECT_NEAR(y(1, 0), 1, 1e-12);
+
+  // D * A * D for D = diag(1e-7, 1): badly scaled, still well conditioned.
+  S21Matrix scaled(2, 2);
+  scaled(0, 0) = 2e-14;
+  scaled(0, 1) = scaled(1, 0) = 1e-7;
+  scaled(1, 1) = 2;
+  rhs(0, 0) = 3e-7;
+  EXPECT_TRUE(S21Cholesky(scaled).IsPositiveDefinite());
+  S21Matrix z =
+      s21_solve(scaled, rhs, S21Structure::kSymmetricPositiveDefinite);
+  EXPECT_NEAR(z(0, 0), 1e7, 1e-3);
+  EXPECT_NEAR(z(1, 0), 1, 1e-9);
+
+  scaled(0, 0) = scaled(0, 1) = scaled(1, 0) = 1;
+  scaled(1, 1) = 1 + 1e-13;
+  EXPECT_FALSE(S21Cholesky(scaled).IsPositiveDefinite());
+}
+
+TEST(S21SolveTest, Triangular) {
+  S21Matrix lower = Filled(30, 30, 5);
+  S21Matrix upper = Filled(30, 30, 7);
+  for (int i = 0; i < 30; ++i) {
+    lower(i, i) = upper(i, i) = 2 + i % 3;
+    for (int j = i + 1; j < 30; ++j) {
+      lower(i, j) = 0;
+      upper(j, i) = 0;
+    }
+  }
+  const S21Matrix b = Filled(30, 4, 8);
+
+  S21Matrix x = s21_solve(lower, b);
+  EXPECT_TRUE((lower * x).EqMatrix(b));
+  EXPECT_TRUE(x.EqMatrix(s21_solve(lower, b, S21Structure::kGeneral)));
+
+  S21Matrix y = b;
+  s21_solve_triangular(upper, y, false);
+  EXPECT_TRUE((upper * y).EqMatrix(b));
+  EXPECT_TRUE(
+      y.EqMatrix(s21_solve(upper, b, S21Structure::kUpperTriangular)));
+
+  lower(7, 7) = 0;
+  EXPECT_THROW(s21_solve(lower, b), std::domain_error);
+  lower(7, 7) = 1e-9 * lower(9, 7);
+  EXPECT_THROW(s21_solve(lower, b), std::domain_error);
+
+  // Only the scale of its own column matters to a diagonal element.
+  S21Matrix scaled(2, 2);
+  scaled(0, 0) = 1e-7;
+  scaled(1, 1) = 1e8;
+  S21Matrix rhs = b;
+  rhs.setRows(2);
+  S21Matrix z = rhs;
+  s21_solve_triangular(scaled, z, false);
+  EXPECT_NEAR(z(0, 0), rhs(0, 0) * 1e7, 1e-3);
+  EXPECT_NEAR(z(1, 0), rhs(1, 0) * 1e-8, 1e-20);
+  EXPECT_TRUE(s21_solve(scaled, rhs).EqMatrix(z));
+}
+
+TYPED_TEST(S21BasicMatrixTest, Solve) {
+  S21BasicMatrix<TypeParam> a(SymmetricPositiveDefinite(20));
+  const S21BasicMatrix<TypeParam> b(Filled(20, 3, 9));
+  S21BasicMatrix<TypeParam> general = this->Dominant(20);
+
+  EXPECT_TRUE((a * s21_solve(a, b)).EqMatrix(b));
+  EXPECT_TRUE((general * s21_solve(general, b)).EqMatrix(b));
+}
+
+TEST(S21QRTest, Factor) {
+  // Several blocks, the last one partial, on a rank-deficient matrix.
+  S21Matrix a = Filled(150, 70, 1);
+  const S21QR qr(a);
+  S21Matrix q = qr.Q();
+  S21Matrix r = qr.R();
+
+  EXPECT_EQ(q.getRows(), 150);
+  EXPECT_EQ(q.getCols(), 70);
+  EXPECT_DOUBLE_EQ(r(40, 3), 0);
+  EXPECT_TRUE((q * r).EqMatrix(a));
+  S21Matrix identity(70, 70);
+  for (int i = 0; i < 70; ++i) {
+    identity(i, i) = 1;
+  }
+  EXPECT_TRUE((q.Transpose() * q).EqMatrix(identity));
+  EXPECT_TRUE(qr.IsRankDeficient());
+
+  S21Matrix b = Filled(150, 3, 2);
+  S21Matrix qtb = b;
+  qr.ApplyQT(qtb);
+  qtb.setRows(70);
+  EXPECT_TRUE((q.Transpose() * b).EqMatrix(qtb));
+
+  EXPECT_THROW(S21QR(Filled(3, 4, 1)), std::domain_error);
+  EXPECT_THROW(qr.ApplyQT(b = S21Matrix(149, 1)), std::invalid_argument);
+  EXPECT_THROW(qr.Solve(Filled(150, 1, 1)), std::domain_error);
+}
+
+TEST(S21QRTest, LeastSquares) {
+  S21Matrix a = Filled(300, 45, 3);
+  for (int j = 0; j < 45; ++j) {
+    a(j, j) += 10;
+  }
+  const S21Matrix b = Filled(300, 2, 4);
+
+  // Against the normal equations A^T * A * X = A^T * B.
+  S21Matrix at = a.Transpose();
+  S21Matrix x = s21_least_squares(a, b);
+  EXPECT_EQ(x.getRows(), 45);
+  EXPECT_EQ(x.getCols(), 2);
+  EXPECT_TRUE(x.EqMatrix(s21_solve(at * a, at * b)));
+  EXPECT_TRUE(S21QR(a).Solve(b).EqMatrix(x));
+
+  // A square system has a zero residual.
+  S21Matrix square = a;
+  square.setRows(45);
+  S21Matrix y = s21_least_squares(square, Filled(45, 1, 5));
+  EXPECT_TRUE((square * y).EqMatrix(Filled(45, 1, 5)));
+
+  EXPECT_THROW(s21_least_squares(Filled(3, 4, 1), Filled(3, 1, 1)),
+               std::domain_error);
+  EXPECT_THROW(s21_least_squares(a, Filled(299, 1, 1)),
+               std::invalid_argument);
+  EXPECT_THROW(s21_least_squares(Filled(60, 40, 1), Filled(60, 1, 1)),
+               std::domain_error);
+
+  // A tiny column is small, not missing: its coefficients grow instead.
+  S21Matrix scaled = a;
+  for (int i = 0; i < 300; ++i) {
+    scaled(i, 5) *= 1e-9;
+  }
+  EXPECT_FALSE(S21QR(scaled).IsRankDeficient());
+  S21Matrix z = s21_least_squares(scaled, b);
+  for (int j = 0; j < 2; ++j) {
+    z(5, j) *= 1e-9;
+  }
+  EXPECT_TRUE(z.EqMatrix(x));
+}
+
+TYPED_TEST(S21BasicMatrixTest, LeastSquares) {
+  S21BasicMatrix<TypeParam> a(Filled(50, 20, 5));
+  for (int j = 0; j < 20; ++j) {
+    a(j, j) += 4;
+  }
+  const S21BasicMatrix<TypeParam> b(Filled(50, 2, 6));
+  S21BasicMatrix<TypeParam> at = a.Transpose();
+
+  S21BasicMatrix<TypeParam> residual = a * s21_least_squares(a, b) - b;
+  S21BasicMatrix<TypeParam> zero(20, 2);
+  EXPECT_TRUE((at * residual).EqMatrix(zero));
+}
+
+// A task that finishes only once the test releases it.
+static S21Task Gate(const S21Matrix& value, std::shared_future<void> open) {
+  return s21_then(S21Task(value), [open](const S21Matrix& mat) {
+    open.wait();
+    return mat;
+  });
+}
+
+TEST(S21AsyncTest, MulAndInverse) {
+  S21Matrix a = Filled(300, 300, 1);
+  for (int i = 0; i < 300; ++i) {
+    a(i, i) += 10;
+  }
+  const S21Matrix b = Filled(300, 120, 2);
+
+  S21Task product = s21_mul_matrix_async(a, b);
+  S21Task inverse = s21_inverse_async(a);
+  S21Matrix expected = a * b;
+  EXPECT_TRUE(expected.EqMatrix(product.Get()));
+  EXPECT_TRUE(a.InverseMatrix().EqMatrix(inverse.Get()));
+  EXPECT_TRUE(product.IsReady());
+  EXPECT_FALSE(product.IsCancelled());
+
+  EXPECT_THROW(s21_mul_matrix_async(b, b).Get(), std::domain_error);
+  EXPECT_THROW(s21_inverse_async(b).Get(), std::domain_error);
+  EXPECT_THROW(s21_inverse_async(S21Matrix(3, 3)).Get(), std::domain_error);
+}
+
+TEST(S21AsyncTest, Graph) {
+  S21Matrix a = Filled(40, 40, 3);
+  for (int i = 0; i < 40; ++i) {
+    a(i, i) += 10;
+  }
+  S21Matrix identity(40, 40);
+  for (int i = 0; i < 40; ++i) {
+    identity(i, i) = 1;
+  }
+
+  // The two products only share their inputs and may run concurrently.
+  const S21Task matrix(a);
+  const S21Task inverse = s21_inverse_async(matrix);
+  const S21Task left = s21_mul_matrix_async(inverse, matrix);
+  const S21Task right = s21_mul_matrix_async(matrix, inverse);
+  const S21Task sum = s21_then(
+      left, right,
+      [](const S21Matrix& x, const S21Matrix& y) -> S21Matrix {
+        return x + y;
+      });
+  identity *= 2;
+  EXPECT_TRUE(identity.EqMatrix(sum.Get()));
+
+  // Failures reach every dependent task.
+  const S21Task failed = s21_inverse_async(S21Matrix(40, 40));
+  const S21Task dependent = s21_mul_matrix_async(failed, matrix);
+  EXPECT_THROW(s21_then(dependent, [](const S21Matrix& x) { return x; }).Get(),
+               std::domain_error);
+}
+
+TEST(S21AsyncTest, Cancel) {
+  std::promise<void> release;
+  const S21Task gate = Gate(Filled(30, 30, 1), release.get_future().share());
+  S21Task product = s21_mul_matrix_async(gate, gate);
+  const S21Task next = s21_inverse_async(product);
+
+  product.Cancel();
+  EXPECT_TRUE(product.IsCancelled());
+  EXPECT_FALSE(product.IsReady());
+  release.set_value();
+
+  EXPECT_TRUE(Filled(30, 30, 1).EqMatrix(gate.Get()));
+  EXPECT_THROW(product.Get(), S21TaskCancelled);
+  EXPECT_THROW(next.Get(), S21TaskCancelled);
+}
+
+struct S21ResumeRecorder {
+  std::promise<void>* resumed;
+  void resume() { resumed->set_value(); }
+};
+
+TEST(S21AsyncTest, Await) {
+  std::promise<void> release;
+  const S21Task gate = Gate(Filled(5, 5, 2), release.get_future().share());
+
+  std::promise<void> resumed;
+  EXPECT_FALSE(gate.await_ready());
+  EXPECT_TRUE(gate.await_suspend(S21ResumeRecorder{&resumed}));
+  release.set_value();
+  resumed.get_future().wait();
+
+  EXPECT_TRUE(gate.await_ready());
+  EXPECT_TRUE(Filled(5, 5, 2).EqMatrix(gate.await_resume()));
+  std::promise<void> unused;
+  EXPECT_FALSE(gate.await_suspend(S21ResumeRecorder{&unused}));
+}
+
+TYPED_TEST(S21BasicMatrixTest, Async) {
+  S21BasicMatrix<TypeParam> a = this->Dominant(30);
+  S21BasicMatrix<TypeParam> b(Filled(30, 10, 4));
+
+  const S21BasicTask<TypeParam> inverse = s21_inverse_async(a);
+  S21BasicMatrix<TypeParam> x =
+      s21_mul_matrix_async(inverse, S21BasicTask<TypeParam>(b)).Get();
+  EXPECT_TRUE((a * x).EqMatrix(b));
+}
+
+TEST(S21MatrixTest, TransposeLarge) {
+  S21Matrix a = Filled(300, 257, 1);
+  S21Matrix t = a.Transpose();
+
+  ASSERT_EQ(t.getRows(), 257);
+  ASSERT_EQ(t.getCols(), 300);
+  for (int i = 0; i < 300; ++i) {
+    for (int j = 0; j < 257; ++j) {
+      ASSERT_EQ(t(j, i), a(i, j));
+    }
+  }
+}
+
+TEST(S21MatrixTest, TransposeInPlace) {
+  // Square, with partial tiles on the right and bottom edges.
+  S21Matrix square = Filled(100, 100, 2);
+  S21Matrix expected = square.Transpose();
+  const double* data = square.data();
+  square.TransposeInPlace();
+  EXPECT_EQ(square.data(), data);
+  EXPECT_TRUE(square.EqMatrix(expected));
+
+  // No row padding either way: cycle-following within the buffer.
+  S21Matrix wide = Filled(16, 40, 3);
+  expected = wide.Transpose();
+  data = wide.data();
+  wide.TransposeInPlace();
+  EXPECT_EQ(wide.data(), data);
+  EXPECT_EQ(wide.getRows(), 40);
+  EXPECT_EQ(wide.getCols(), 16);
+  EXPECT_TRUE(wide.EqMatrix(expected));
+
+  // Padded rows: the result needs a buffer of another size.
+  S21Matrix narrow = Filled(5, 3, 4);
+  expected = narrow.Transpose();
+  narrow.TransposeInPlace();
+  EXPECT_EQ(narrow.getRows(), 3);
+  EXPECT_EQ(narrow.getCols(), 5);
+  EXPECT_EQ(narrow.getStride(), 8);
+  EXPECT_TRUE(narrow.EqMatrix(expected));
+
+  S21Matrix single;
+  single(0, 0) = 5;
+  single.TransposeInPlace();
+  EXPECT_DOUBLE_EQ(single(0, 0), 5);
+}
+
+TYPED_TEST(S21BasicMatrixTest, Transpose) {
+  S21BasicMatrix<TypeParam> square(Filled(70, 70, 1));
+  S21BasicMatrix<TypeParam> expected = square.Transpose();
+  EXPECT_EQ(expected(3, 65), square(65, 3));
+  square.TransposeInPlace();
+  EXPECT_TRUE(square.EqMatrix(expected));
+
+  S21BasicMatrix<TypeParam> wide(Filled(48, 64, 2));
+  expected = wide.Transpose();
+  wide.TransposeInPlace();
+  EXPECT_TRUE(wide.EqMatrix(expected));
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();